@@ -4,6 +4,12 @@ import subprocess
 import json
 import os
 import csv
+import mmap
+import struct
+import tempfile
+import socket
+from array import array
+from itertools import repeat
 
 app = Flask(__name__)
 
@@ -21,18 +27,111 @@ CPP_MERGE_EXECUTABLE = './bin/merge_sort.exe'
 CPP_QUICK_EXECUTABLE = "./bin/quick_sort.exe"
 DATA_CSV = './data/customer_shopping_data.csv'
 
+# sort-server (sort-server.cpp): proses C++ yang tetap hidup dengan CSV dan thread
+# pool yang sudah siap. Jika socket tidak ada, cpp_sort kembali ke subprocess
+SORT_SERVER_SOCKET = os.environ.get("SORT_SERVER_SOCKET", "/tmp/sort-server.sock")
+SORT_SERVER_ALGOS = {"QUICK": "quick", "MERGE": "merge", "RADIX": "radix"}
+
+def run_sorter(algo, exe, args):
+    """Jalankan sort, return (ok, stdout, pesan error). Lewat sort-server jika
+    tersedia, jika tidak menjalankan exe sebagai subprocess seperti sebelumnya."""
+    name = SORT_SERVER_ALGOS.get(algo)
+    # Request dikirim sebagai satu baris dipisah spasi: argumen kosong / berisi spasi lewat subprocess
+    one_line = not any(arg.split() != [arg] for arg in args)
+    if name and one_line and hasattr(socket, "AF_UNIX") and os.path.exists(SORT_SERVER_SOCKET):
+        try:
+            with socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as conn:
+                conn.connect(SORT_SERVER_SOCKET)
+                conn.sendall((" ".join([name] + args) + "\n").encode())
+                chunks = []
+                while True:
+                    chunk = conn.recv(1 << 20)
+                    if not chunk:
+                        break
+                    chunks.append(chunk)
+        except OSError:
+            pass  # Server mati / socket basi: pakai subprocess
+        else:
+            # Balasan: "OK\n" + stdout program sort, atau "ERROR <pesan>\n"
+            status, _, output = b"".join(chunks).decode().partition("\n")
+            if status == "OK":
+                return True, output, ""
+            return False, "", status[len("ERROR "):]
+
+    result = subprocess.run([exe] + args, capture_output=True, text=True)
+    return result.returncode == 0, result.stdout, result.stderr.strip()
+
+# Format file --format binary, lihat column-writer.hpp
+COLUMN_FILE_MAGIC = b'SORTCOLS'
+COLUMN_FILE_VERSION = 1
+COLUMN_FILE_HEADER = struct.Struct('<8sIIQqQQ')
+COLUMN_FILE_ENTRY = struct.Struct('<32sQQ')
+
+def read_uint32_array(mm, pos, count):
+    values = array('I')
+    values.frombytes(mm[pos:pos + 4 * count])
+    return values
+
+def read_sorted_columns(path):
+    """Baca file hasil --format binary lewat mmap, tanpa parsing teks.
+    ValueError jika file kosong / bukan file kolom (mis. exe lama yang mengabaikan --format)."""
+    with open(path, 'rb') as f:
+        header = f.read(COLUMN_FILE_HEADER.size)
+        if len(header) < COLUMN_FILE_HEADER.size:
+            raise ValueError("Invalid sorted column file")
+        magic, version, num_columns, num_rows, duration, _, _ = COLUMN_FILE_HEADER.unpack(header)
+        if magic != COLUMN_FILE_MAGIC or version != COLUMN_FILE_VERSION:
+            raise ValueError("Invalid sorted column file")
+        mm = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+
+    try:
+        names = []
+        columns = []
+        for c in range(num_columns):
+            pos = COLUMN_FILE_HEADER.size + c * COLUMN_FILE_ENTRY.size
+            name, offsets_pos, data_pos = COLUMN_FILE_ENTRY.unpack_from(mm, pos)
+            offsets = read_uint32_array(mm, offsets_pos, num_rows + 1)
+            data = mm[data_pos:data_pos + offsets[num_rows]]
+            names.append(name.rstrip(b'\0').decode())
+            # Setiap nilai diakhiri '\0': satu split untuk seluruh kolom
+            columns.append(data.decode().split('\0')[:num_rows])
+
+        return {
+            "duration": duration,
+            "data": list(map(dict, map(zip, repeat(names), zip(*columns)))),
+        }
+    finally:
+        mm.close()
+
 @app.route('/')
 def index():
     return render_template('index.html')
 
+# Baris CSV di-cache per mtime file, dipakai /all dan /cpp-sort?format=indices
+csv_cache = {"mtime": None, "rows": []}
+
+def load_rows():
+    mtime = os.path.getmtime(DATA_CSV)
+    if csv_cache["mtime"] != mtime:
+        with open(DATA_CSV, newline='', encoding='utf-8') as f:
+            csv_cache["rows"] = list(csv.DictReader(f))
+        csv_cache["mtime"] = mtime
+    return csv_cache["rows"]
+
+def read_sorted_indices(path):
+    """Baca file hasil --format indices: uint32 nomor baris data per posisi sort."""
+    if os.path.getsize(path) == 0:  # mmap tidak bisa untuk file kosong
+        return []
+    with open(path, 'rb') as f:
+        mm = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+    try:
+        return read_uint32_array(mm, 0, len(mm) // 4)
+    finally:
+        mm.close()
+
 @app.route('/all')
 def all():
-    rows = []
-
-    with open(DATA_CSV, newline='', encoding='utf-8') as f:
-        reader = csv.DictReader(f)
-        for r in reader:
-            rows.append(r)
+    rows = load_rows()
 
     return jsonify({
         "status": "success",
@@ -57,8 +156,71 @@ def cpp_sort():
     else:
         return jsonify({"status": "error", "message": "Unknown algo"}), 400
 
-    result = subprocess.run([exe, field], capture_output=True, text=True)
-    output = result.stdout
+    # limit / offset: hanya satu halaman hasil sort (partial sort di sisi C++)
+    args = [field]
+    for name in ("limit", "offset"):
+        value = request.args.get(name)
+        if value is None:
+            continue
+        if algo == "MERGE_SEQ":  # merge_sort_seq.exe hanya membaca argv[1]
+            return jsonify({"status": "error", "message": f"{name} is not supported by {algo}"}), 400
+        if not value.isdigit():
+            return jsonify({"status": "error", "message": f"Invalid {name}"}), 400
+        args += ["--" + name, value]
+
+    # format=indices: C++ hanya mengirim urutan, baris diambil dari CSV yang sudah dimuat
+    if request.args.get("format") == "indices":
+        fd, out_path = tempfile.mkstemp(suffix=".idx")
+        os.close(fd)
+        try:
+            ok, output, error = run_sorter(algo, exe, args + ["--format", "indices", "--output", out_path])
+            if not ok:
+                return jsonify({"status": "error", "message": error}), 500
+            order = read_sorted_indices(out_path)
+        finally:
+            os.remove(out_path)
+
+        start = output.find("---START_JSON---")
+        end = output.find("---END_JSON---")
+        if start == -1 or end == -1:
+            return jsonify({"status": "error", "message": "Invalid JSON output"}), 500
+        meta = json.loads(output[start + len("---START_JSON---"):end].strip())
+
+        # Exe lama (mis. MERGE_SEQ) mengabaikan --format: file kosong, stdout berisi JSON biasa
+        if meta.get("format") != "indices" or meta.get("rows") != len(order):
+            return jsonify({"status": "error", "message": "Sorter did not write an indices file"}), 500
+
+        rows = load_rows()
+        return jsonify({
+            "status": "success",
+            "duration": meta["duration"],
+            "data": [rows[i] for i in order]
+        })
+
+    # format=binary: hasil dibaca dari file kolom (mmap), bukan JSON di stdout
+    if request.args.get("format") == "binary":
+        fd, out_path = tempfile.mkstemp(suffix=".bin")
+        os.close(fd)
+        try:
+            ok, output, error = run_sorter(algo, exe, args + ["--format", "binary", "--output", out_path])
+            if not ok:
+                return jsonify({"status": "error", "message": error}), 500
+            try:
+                table = read_sorted_columns(out_path)
+            except ValueError as e:
+                return jsonify({"status": "error", "message": str(e)}), 500
+        finally:
+            os.remove(out_path)
+
+        return jsonify({
+            "status": "success",
+            "duration": table["duration"],
+            "data": table["data"]
+        })
+
+    ok, output, error = run_sorter(algo, exe, args)
+    if not ok:
+        return jsonify({"status": "error", "message": error}), 500
 
     start = output.find("---START_JSON---") + len("---START_JSON---")
     end = output.find("---END_JSON---")
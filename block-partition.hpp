@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "csv-reader.hpp"
+
+// ==========================================
+// BlockQuicksort Partition (KeyIndex)
+// ==========================================
+
+// Ukuran blok: offset disimpan di buffer uint8_t, jadi maksimal 256
+const int PARTITION_BLOCK = 128;
+
+// Partisi branchless ala BlockQuicksort (Edelkamp & Weiss) untuk KeyIndex.
+// Hasil: [first, mid) memenuhi key < pivot (atau <= jika OrEqual), [mid, last) tidak.
+//
+// Alih-alih "if (key < pivot) swap" yang salah tebak ~50% pada key acak,
+// setiap blok di kiri dan kanan di-scan tanpa cabang: posisi elemen yang salah
+// sisi ditulis ke buffer offset dan counter ditambah dengan hasil perbandingan
+// (0/1). Setelah itu pasangan offset kiri/kanan ditukar dalam satu batch.
+template <bool OrEqual = false>
+inline KeyIndex *blockPartition(KeyIndex *first, KeyIndex *last, long long pivot) {
+    auto goesLeft = [pivot](const KeyIndex &k) {
+        return OrEqual ? k.sort_key <= pivot : k.sort_key < pivot;
+    };
+
+    std::uint8_t offsets_l[PARTITION_BLOCK], offsets_r[PARTITION_BLOCK];
+    int start_l = 0, num_l = 0; // Offset salah sisi yang belum ditukar di blok kiri
+    int start_r = 0, num_r = 0; // Offset salah sisi yang belum ditukar di blok kanan
+
+    KeyIndex *l = first; // Semua elemen sebelum l sudah benar (< pivot)
+    KeyIndex *r = last;  // Semua elemen mulai r sudah benar (>= pivot)
+
+    while (r - l > 2 * PARTITION_BLOCK) {
+        // Scan blok kiri [l, l + B): catat elemen yang seharusnya di kanan
+        if (num_l == 0) {
+            start_l = 0;
+            for (int i = 0; i < PARTITION_BLOCK; i++) {
+                offsets_l[num_l] = (std::uint8_t)i;
+                num_l += !goesLeft(l[i]);
+            }
+        }
+        // Scan blok kanan [r - B, r): catat elemen yang seharusnya di kiri
+        if (num_r == 0) {
+            start_r = 0;
+            for (int i = 0; i < PARTITION_BLOCK; i++) {
+                offsets_r[num_r] = (std::uint8_t)i;
+                num_r += goesLeft(*(r - 1 - i));
+            }
+        }
+
+        // Tukar pasangan salah sisi dalam satu batch
+        int num = std::min(num_l, num_r);
+        for (int j = 0; j < num; j++) {
+            std::swap(l[offsets_l[start_l + j]], *(r - 1 - offsets_r[start_r + j]));
+        }
+        num_l -= num;
+        num_r -= num;
+        start_l += num;
+        start_r += num;
+
+        // Blok yang sudah bersih digeser
+        if (num_l == 0) l += PARTITION_BLOCK;
+        if (num_r == 0) r -= PARTITION_BLOCK;
+    }
+
+    // Sisa (maksimal beberapa blok) diselesaikan dengan partisi biasa
+    return std::partition(l, r, goesLeft);
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "csv-reader.hpp"
+
+// ==========================================
+// Binary Columnar Output
+// ==========================================
+
+// Format file (little-endian, setiap section dimulai di posisi kelipatan 8):
+//
+//   Header, 48 byte
+//     0   char[8]   magic "SORTCOLS"
+//     8   uint32    version (COLUMN_FILE_VERSION)
+//     12  uint32    num_columns
+//     16  uint64    num_rows
+//     24  int64     duration_ms (waktu sort saja)
+//     32  uint64    permutation_pos
+//     40  uint64    reserved (0)
+//
+//   Directory, num_columns x 48 byte (urutan kolom sama dengan CSV)
+//     0   char[32]  nama kolom, diisi '\0'
+//     32  uint64    offsets_pos: uint32[num_rows + 1], awal nilai ke-i relatif ke data_pos
+//     40  uint64    data_pos: semua nilai berurutan, masing-masing diakhiri '\0',
+//                   panjang total offsets[num_rows]
+//
+//   Permutation: uint32[num_rows], nomor baris data di CSV (0-based, tanpa
+//   header) untuk setiap posisi hasil sort
+//
+// Nilai ke-i kolom c = data[offsets[i] .. offsets[i + 1] - 1), tanpa escape.
+// Terminator '\0' membuat satu kolom bisa dipecah sekaligus (mis. split di
+// Python) tanpa membaca offset satu per satu.
+// Semua posisi absolut dari awal file, jadi pembaca cukup mmap lalu slice.
+
+const char COLUMN_FILE_MAGIC[8] = {'S', 'O', 'R', 'T', 'C', 'O', 'L', 'S'};
+const std::uint32_t COLUMN_FILE_VERSION = 1;
+
+struct ColumnFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t num_columns;
+    std::uint64_t num_rows;
+    std::int64_t duration_ms;
+    std::uint64_t permutation_pos;
+    std::uint64_t reserved;
+};
+
+struct ColumnFileEntry {
+    char name[32];
+    std::uint64_t offsets_pos;
+    std::uint64_t data_pos;
+};
+
+static_assert(sizeof(ColumnFileHeader) == 48, "ColumnFileHeader harus 48 byte");
+static_assert(sizeof(ColumnFileEntry) == 48, "ColumnFileEntry harus 48 byte");
+
+// Mode --format indices: file berisi uint32[num_rows] saja (sama dengan section
+// Permutation di atas, tanpa header). Untuk pemanggil yang sudah memegang data
+// CSV sendiri dan cukup menerapkan urutannya.
+inline bool writeSortedIndices(const std::string &path, const std::vector<CustomerData> &data_customers,
+                               const std::vector<KeyIndex> *keys) {
+    std::vector<std::uint32_t> permutation;
+    permutation.reserve(sortedCount(data_customers, keys));
+    forEachSorted(data_customers, keys, [&](const CustomerData &item) { permutation.push_back(item.row); });
+
+    std::FILE *f = std::fopen(path.c_str(), "wb");
+    if (!f) {
+        std::cerr << "[ERROR] Cannot open output file: " << path << "\n";
+        return false;
+    }
+    std::size_t bytes = permutation.size() * sizeof(std::uint32_t);
+    bool ok = bytes == 0 || std::fwrite(permutation.data(), 1, bytes, f) == bytes;
+    if (std::fclose(f) != 0) ok = false;
+    if (!ok) {
+        std::cerr << "[ERROR] Failed writing output file: " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+// Tulis hasil sort ke path dalam format di atas. Return false (dan pesan di cerr) jika gagal
+inline bool writeSortedColumns(const std::string &path, long long duration_ms,
+                               const std::vector<CustomerData> &data_customers, const std::vector<KeyIndex> *keys) {
+    std::size_t n = sortedCount(data_customers, keys);
+
+    // Kumpulkan permutasi dan setiap kolom dalam satu pass atas hasil sort
+    std::vector<std::uint32_t> permutation;
+    std::vector<std::uint32_t> offsets[NUM_COLUMNS];
+    std::string bytes[NUM_COLUMNS];
+    permutation.reserve(n);
+    for (int c = 0; c < NUM_COLUMNS; c++) {
+        offsets[c].reserve(n + 1);
+        offsets[c].push_back(0);
+    }
+
+    bool overflow = false;
+    forEachSorted(data_customers, keys, [&](const CustomerData &item) {
+        permutation.push_back(item.row);
+        CsvTokenizer tokens(recordLine(item));
+        std::string_view field;
+        for (int c = 0; c < NUM_COLUMNS; c++) {
+            if (!tokens.next(field)) field = std::string_view();
+            bytes[c].append(field.data(), field.size());
+            bytes[c].push_back('\0');
+            if (bytes[c].size() > UINT32_MAX) overflow = true;
+            offsets[c].push_back((std::uint32_t)bytes[c].size());
+        }
+    });
+    if (overflow) {
+        std::cerr << "[ERROR] Column larger than 4 GB, cannot write binary output\n";
+        return false;
+    }
+
+    // Hitung posisi setiap section
+    auto align8 = [](std::uint64_t pos) { return (pos + 7) & ~(std::uint64_t)7; };
+    ColumnFileHeader header = {};
+    ColumnFileEntry entries[NUM_COLUMNS] = {};
+    std::uint64_t pos = sizeof(header) + sizeof(entries);
+
+    std::memcpy(header.magic, COLUMN_FILE_MAGIC, sizeof(header.magic));
+    header.version = COLUMN_FILE_VERSION;
+    header.num_columns = NUM_COLUMNS;
+    header.num_rows = n;
+    header.duration_ms = duration_ms;
+    header.permutation_pos = pos;
+    pos = align8(pos + n * sizeof(std::uint32_t));
+
+    for (int c = 0; c < NUM_COLUMNS; c++) {
+        std::strncpy(entries[c].name, csv_columns[c], sizeof(entries[c].name) - 1);
+        entries[c].offsets_pos = pos;
+        pos = align8(pos + offsets[c].size() * sizeof(std::uint32_t));
+        entries[c].data_pos = pos;
+        pos = align8(pos + bytes[c].size());
+    }
+
+    std::FILE *f = std::fopen(path.c_str(), "wb");
+    if (!f) {
+        std::cerr << "[ERROR] Cannot open output file: " << path << "\n";
+        return false;
+    }
+
+    // Tulis berurutan, padding '\0' sampai posisi section berikutnya
+    std::uint64_t written = 0;
+    bool ok = true;
+    auto put = [&](const void *src, std::size_t size) {
+        if (size > 0 && std::fwrite(src, 1, size, f) != size) ok = false;
+        written += size;
+    };
+    auto padTo = [&](std::uint64_t target) {
+        static const char zeros[8] = {0};
+        put(zeros, (std::size_t)(target - written));
+    };
+
+    put(&header, sizeof(header));
+    put(entries, sizeof(entries));
+    put(permutation.data(), permutation.size() * sizeof(std::uint32_t));
+    for (int c = 0; c < NUM_COLUMNS; c++) {
+        padTo(entries[c].offsets_pos);
+        put(offsets[c].data(), offsets[c].size() * sizeof(std::uint32_t));
+        padTo(entries[c].data_pos);
+        put(bytes[c].data(), bytes[c].size());
+    }
+    padTo(pos);
+
+    if (std::fclose(f) != 0) ok = false;
+    if (!ok) {
+        std::cerr << "[ERROR] Failed writing output file: " << path << "\n";
+        return false;
+    }
+    return true;
+}
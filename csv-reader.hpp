@@ -0,0 +1,549 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "delimiter-scan.hpp"
+
+// ==========================================
+// Data Structures & Helpers
+// ==========================================
+
+// Satu baris CSV tidak lagi disimpan sebagai std::string, cukup posisi
+// (offset/length) di dalam file yang sudah di-mmap (lihat csv_file).
+struct CustomerData {
+    long long sort_key;
+    std::size_t offset;   // Posisi awal baris di dalam csv_file
+    std::uint32_t length; // Panjang baris tanpa '\n' / '\r'
+    std::uint32_t row;    // Nomor baris data di file (0-based, tanpa header & baris kosong)
+};
+
+// Mode key-index: yang di-sort hanya pasangan (sort_key, index), 16 byte di
+// x86-64, CustomerData tidak pernah dipindah. Urutan diterapkan saat output.
+struct KeyIndex {
+    long long sort_key;
+    std::uint32_t index; // Indeks ke data_customers (bukan CustomerData::row)
+};
+
+// Urutan asli record di file, dipakai sebagai tiebreak untuk sort stabil
+inline std::size_t recordOrder(const CustomerData &item) { return item.offset; }
+inline std::size_t recordOrder(const KeyIndex &item) { return item.index; }
+
+// Kolom CSV sesuai urutan di customer_shopping_data.csv
+enum CsvColumn {
+    COL_INVOICE_NO = 0,
+    COL_CUSTOMER_ID,
+    COL_GENDER,
+    COL_AGE,
+    COL_CATEGORY,
+    COL_QUANTITY,
+    COL_PRICE,
+    COL_PAYMENT_METHOD,
+    COL_INVOICE_DATE,
+    COL_SHOPPING_MALL,
+    NUM_COLUMNS
+};
+
+inline const char *const csv_columns[NUM_COLUMNS] = {
+    "invoice_no", "customer_id", "gender", "age", "category",
+    "quantity", "price", "payment_method", "invoice_date", "shopping_mall"
+};
+
+// Cari indeks kolom dari nama field, -1 jika tidak dikenal
+inline int findColumn(const std::string &field) {
+    for (int c = 0; c < NUM_COLUMNS; c++) {
+        if (field == csv_columns[c]) return c;
+    }
+    return -1;
+}
+
+// Tokenizer tanpa alokasi: scan baris sekali, setiap field dikembalikan
+// sebagai std::string_view yang menunjuk langsung ke baris aslinya.
+class CsvTokenizer {
+private:
+    std::string_view line;
+    std::size_t pos;
+    bool done;
+
+public:
+    explicit CsvTokenizer(std::string_view line) : line(line), pos(0), done(false) {}
+
+    // Ambil field berikutnya, return false jika semua field sudah dibaca
+    bool next(std::string_view &field) {
+        if (done) return false;
+        std::size_t comma = line.find(',', pos);
+        if (comma == std::string_view::npos) {
+            field = line.substr(pos);
+            done = true;
+        } else {
+            field = line.substr(pos, comma - pos);
+            pos = comma + 1;
+        }
+        return true;
+    }
+};
+
+// ==========================================
+// Key Parsers
+// ==========================================
+
+// Semua parser bekerja langsung di atas string_view: tanpa alokasi, tanpa
+// exception, tanpa floating point. Return false jika format tidak valid.
+
+// Parse digit desimal tanpa tanda (maksimal 18 digit agar tidak overflow)
+inline bool parseDigits(std::string_view s, long long &value) {
+    if (s.empty() || s.size() > 18) return false;
+    long long v = 0;
+    for (char c : s) {
+        unsigned digit = (unsigned)(c - '0');
+        if (digit > 9) return false;
+        v = v * 10 + digit;
+    }
+    value = v;
+    return true;
+}
+
+// Parse integer dengan tanda opsional, contoh "5" atau "-12"
+inline bool parseInteger(std::string_view s, long long &value) {
+    bool negative = !s.empty() && s[0] == '-';
+    if (!parseDigits(s.substr(negative), value)) return false;
+    if (negative) value = -value;
+    return true;
+}
+
+// Parse ID dengan prefix huruf, contoh "I138884" / "C241288" -> 138884 / 241288
+inline bool parsePrefixedInteger(std::string_view s, long long &value) {
+    std::size_t i = 0;
+    while (i < s.size() && (unsigned)((s[i] | 0x20) - 'a') < 26) i++; // Lewati huruf prefix
+    return parseDigits(s.substr(i), value);
+}
+
+// Parse harga desimal langsung ke cent, contoh "1500.4" -> 150040, "5.23" -> 523.
+// Tidak lewat double sehingga tidak ada error pembulatan (15.15 tetap 1515).
+// Digit pecahan ketiga dan seterusnya dibulatkan half-up.
+inline bool parseCents(std::string_view s, long long &value) {
+    bool negative = !s.empty() && s[0] == '-';
+    if (negative) s.remove_prefix(1);
+
+    std::size_t dot = s.find('.');
+    std::string_view whole = s.substr(0, dot);
+    std::string_view frac = (dot == std::string_view::npos) ? std::string_view() : s.substr(dot + 1);
+
+    long long units = 0;
+    if (whole.empty() ? frac.empty() : !parseDigits(whole, units)) return false;
+
+    long long cents = 0;
+    if (!frac.empty()) {
+        long long ignored;
+        if (!parseDigits(frac.substr(0, 17), ignored)) return false; // Validasi semua digit pecahan
+
+        unsigned d0 = (unsigned)(frac[0] - '0');
+        unsigned d1 = frac.size() > 1 ? (unsigned)(frac[1] - '0') : 0;
+        unsigned d2 = frac.size() > 2 ? (unsigned)(frac[2] - '0') : 0;
+        cents = d0 * 10 + d1 + (d2 >= 5);
+    }
+
+    value = units * 100 + cents;
+    if (negative) value = -value;
+    return true;
+}
+
+// Convert invoice date "DD/MM/YYYY" (hari/bulan boleh 1 digit) -> YYYYMMDD
+inline bool convertDate(std::string_view s, long long &value) {
+    // Hari: 1 atau 2 digit sebelum '/'
+    std::size_t i = (s.size() > 1 && s[1] == '/') ? 1 : 2;
+    if (s.size() < i + 7 || s[i] != '/') return false; // Minimal "D/M/YYYY"
+
+    // Bulan: 1 atau 2 digit sebelum '/'
+    std::size_t j = (s[i + 2] == '/') ? i + 2 : i + 3;
+    if (s.size() != j + 5 || s[j] != '/') return false; // Tahun selalu 4 digit
+
+    // parseDigits menolak karakter non-digit di hari, bulan dan tahun
+    long long d, m, y;
+    if (!parseDigits(s.substr(0, i), d) || !parseDigits(s.substr(i + 1, j - i - 1), m)) return false;
+    if (!parseDigits(s.substr(j + 1, 4), y)) return false;
+    if (d == 0 || d > 31 || m == 0 || m > 12) return false;
+
+    value = y * 10000 + m * 100 + d; // return in format YYYYMMDD as long long
+    return true;
+}
+
+// Hitung sort_key dari isi kolom yang dipilih, return false jika gagal di-parse
+inline bool parseSortKey(int column, std::string_view field, long long &key) {
+    switch (column) {
+        case COL_INVOICE_NO:
+        case COL_CUSTOMER_ID:
+            return parsePrefixedInteger(field, key); // "I123456" / "C123456"
+        case COL_QUANTITY:
+            return parseInteger(field, key);
+        case COL_PRICE:
+            return parseCents(field, key); // harga -> cent
+        case COL_INVOICE_DATE:
+            return convertDate(field, key); // YYYYMMDD
+        default:
+            key = 0; // Field lain tidak punya key numerik
+            return true;
+    }
+}
+
+// ==========================================
+// Bagian Header (MappedFile)
+// ==========================================
+
+// File read-only yang di-map sekali ke memori (mmap / MapViewOfFile).
+// Semua CustomerData menunjuk ke buffer ini, jadi objek ini harus hidup
+// selama data masih dipakai (termasuk saat menulis output).
+class MappedFile {
+private:
+    const char *bytes;  // Awal mapping (nullptr jika file kosong / belum dibuka)
+    std::size_t length; // Ukuran file dalam byte
+    std::vector<char> copy; // Isi file jika dibuka dengan load() (tanpa mapping)
+#ifdef _WIN32
+    HANDLE file_handle;
+    HANDLE mapping_handle;
+#else
+    int fd;
+#endif
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool open(const std::string &filename); // Map seluruh file, return false jika gagal
+    void close();                           // Lepas mapping
+
+    // Salin seluruh file ke memori, bukan mapping. Untuk proses yang hidup lama
+    // (sort-server): file yang dipotong / ditimpa saat dipakai tidak bisa memicu
+    // SIGBUS. Return false jika gagal dibaca
+    bool load(const std::string &filename);
+
+    const char *data() const { return bytes; }
+    std::size_t size() const { return length; }
+
+    std::string_view slice(std::size_t offset, std::size_t len) const {
+        return std::string_view(bytes + offset, len);
+    }
+};
+
+// ==========================================
+// Bagian Implementasi (MappedFile)
+// ==========================================
+
+#ifdef _WIN32
+
+inline MappedFile::MappedFile()
+    : bytes(nullptr), length(0), file_handle(INVALID_HANDLE_VALUE), mapping_handle(nullptr) {
+}
+
+inline bool MappedFile::open(const std::string &filename) {
+    close();
+
+    file_handle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file_handle == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file_handle, &file_size)) {
+        close();
+        return false;
+    }
+    length = (std::size_t)file_size.QuadPart;
+    if (length == 0) return true; // File kosong tidak bisa di-map, tapi tetap valid
+
+    mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_handle == nullptr) {
+        close();
+        return false;
+    }
+
+    bytes = (const char *)MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+    if (bytes == nullptr) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+inline void MappedFile::close() {
+    if (bytes && copy.empty()) UnmapViewOfFile(bytes);
+    if (mapping_handle) CloseHandle(mapping_handle);
+    if (file_handle != INVALID_HANDLE_VALUE) CloseHandle(file_handle);
+    bytes = nullptr;
+    length = 0;
+    std::vector<char>().swap(copy);
+    mapping_handle = nullptr;
+    file_handle = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+inline MappedFile::MappedFile() : bytes(nullptr), length(0), fd(-1) {
+}
+
+inline bool MappedFile::open(const std::string &filename) {
+    close();
+
+    fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close();
+        return false;
+    }
+    length = (std::size_t)st.st_size;
+    if (length == 0) return true; // File kosong tidak bisa di-map, tapi tetap valid
+
+    void *addr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+        close();
+        return false;
+    }
+    madvise(addr, length, MADV_SEQUENTIAL); // Hint ke kernel: dibaca berurutan
+    bytes = (const char *)addr;
+    return true;
+}
+
+inline void MappedFile::close() {
+    if (bytes && copy.empty()) munmap((void *)bytes, length);
+    if (fd >= 0) ::close(fd);
+    bytes = nullptr;
+    length = 0;
+    std::vector<char>().swap(copy);
+    fd = -1;
+}
+
+#endif
+
+inline MappedFile::~MappedFile() {
+    close();
+}
+
+inline bool MappedFile::load(const std::string &filename) {
+    close();
+
+    std::FILE *f = std::fopen(filename.c_str(), "rb");
+    if (!f) return false;
+
+    // Baca per blok sampai EOF: ukuran file bisa berubah selama dibaca
+    const std::size_t CHUNK = 1 << 20;
+    std::vector<char> buffer;
+    std::size_t used = 0;
+    while (true) {
+        buffer.resize(used + CHUNK);
+        std::size_t n = std::fread(buffer.data() + used, 1, CHUNK, f);
+        used += n;
+        if (n < CHUNK) break;
+    }
+    bool ok = !std::ferror(f);
+    std::fclose(f);
+    if (!ok) return false;
+
+    buffer.resize(used);
+    copy.swap(buffer);
+    bytes = copy.empty() ? nullptr : copy.data();
+    length = copy.size();
+    return true;
+}
+
+// ==========================================
+// Bagian CSV Handling
+// ==========================================
+
+// Global variable untuk header CSV agar bisa disimpan ulang
+inline std::string csv_header = "";
+
+// File CSV yang sedang dipakai, semua CustomerData menunjuk ke sini
+inline MappedFile csv_file;
+
+// Ambil isi baris asli dari sebuah record (tanpa alokasi)
+inline std::string_view recordLine(const CustomerData &item) {
+    return csv_file.slice(item.offset, item.length);
+}
+
+// Parse semua baris di dalam [begin, end) ke vector milik satu thread.
+// Return jumlah baris tidak kosong (termasuk yang gagal di-parse); row setiap
+// record masih relatif terhadap awal range dan dijadikan absolut oleh readCSV.
+// begin harus berada tepat di awal baris. Byte tidak dibaca satu per satu:
+// kernel SIMD menandai posisi ',' dan '\n' per blok 64 byte, lalu parser
+// hanya melompat dari delimiter ke delimiter untuk menemukan kolom sort.
+inline std::uint32_t parseCSVRange(std::size_t begin, std::size_t end, const std::string &sortField, std::vector<CustomerData> &out)
+{
+    const char *base = csv_file.data();
+    int column = findColumn(sortField);
+
+    std::size_t row_start = begin;   // Awal baris yang sedang dibaca
+    std::size_t field_start = begin; // Awal kolom sort di baris ini
+    std::size_t field_end = begin;   // Akhir kolom sort (jika bukan kolom terakhir)
+    int field_index = 0;             // Jumlah koma yang sudah dilewati di baris ini
+    std::uint32_t rows = 0;          // Baris tidak kosong yang sudah dilewati
+
+    // Dipanggil di setiap '\n' (atau akhir range): simpan record lalu reset state baris
+    auto finishRow = [&](std::size_t line_end) {
+        std::size_t next = line_end + 1;
+        if (line_end > row_start && base[line_end - 1] == '\r') line_end--; // Buang '\r' (CRLF)
+
+        if (line_end > row_start) {
+            long long key = 0;
+            bool ok = true;
+            if (column >= 0) {
+                // Baris yang lebih pendek dari kolom sort diperlakukan sebagai field kosong:
+                // kolom ber-key numerik gagal di-parse, kolom lain tetap masuk dengan key 0
+                std::string_view field;
+                if (field_index >= column) {
+                    std::size_t end_of_field = (field_index == column) ? line_end : field_end;
+                    field = std::string_view(base + field_start, end_of_field - field_start);
+                }
+                ok = parseSortKey(column, field, key);
+            }
+            if (ok) { // Skip lines with parse errors
+                out.push_back({key, row_start, (std::uint32_t)(line_end - row_start), rows});
+            }
+            rows++;
+        }
+
+        row_start = next;
+        field_start = next;
+        field_index = 0;
+    };
+
+    forEachDelimiterBlock(base + begin, base + end, [&](std::size_t block, DelimiterMask mask) {
+        std::uint64_t bits = mask.commas | mask.newlines;
+        while (bits) {
+            int bit = lowestBit(bits);
+            bits &= bits - 1;
+            std::size_t p = begin + block + bit;
+
+            if ((mask.newlines >> bit) & 1) {
+                finishRow(p);
+            } else {
+                field_index++;
+                if (field_index == column) field_start = p + 1;
+                else if (field_index == column + 1) field_end = p;
+            }
+        }
+    });
+
+    if (row_start < end) finishRow(end); // Baris terakhir tanpa '\n'
+    return rows;
+}
+
+// Parse csv_file yang sudah di-map untuk kolom sortField: file dipecah menjadi
+// potongan per core. Batas tiap potongan digeser ke awal baris berikutnya, setiap
+// thread mem-parse potongannya ke vector lokal, lalu semua hasil digabung sesuai
+// urutan file. Dipisah dari readCSV agar sort-server bisa mem-parse field lain
+// tanpa membuka ulang file
+inline void parseCSV(const std::string &sortField, std::vector<CustomerData> &data_customers)
+{
+    const char *base = csv_file.data();
+    std::size_t size = csv_file.size();
+    if (size == 0) return;
+
+    // Header adalah baris pertama
+    const char *nl = (const char *)std::memchr(base, '\n', size);
+    std::size_t header_end = nl ? (std::size_t)(nl - base) : size;
+    std::size_t body_start = nl ? header_end + 1 : size;
+    if (header_end > 0 && base[header_end - 1] == '\r') header_end--;
+    csv_header.assign(base, header_end);
+
+    // Deteksi otomatis jumlah Core CPU, potongan minimal 1 MB agar overhead thread sepadan
+    unsigned int cores = std::thread::hardware_concurrency();
+    if (cores == 0) cores = 2;
+    const std::size_t MIN_CHUNK = 1 << 20;
+    std::size_t body_size = size - body_start;
+    std::size_t num_chunks = std::max<std::size_t>(1, std::min<std::size_t>(cores, body_size / MIN_CHUNK));
+
+    // Batas potongan: geser ke byte setelah '\n' berikutnya
+    std::vector<std::size_t> bounds(num_chunks + 1);
+    bounds[0] = body_start;
+    bounds[num_chunks] = size;
+    for (std::size_t c = 1; c < num_chunks; c++) {
+        std::size_t guess = std::max(body_start + body_size / num_chunks * c, bounds[c - 1]);
+        const char *next = (const char *)std::memchr(base + guess, '\n', size - guess);
+        bounds[c] = next ? (std::size_t)(next - base) + 1 : size;
+    }
+
+    std::vector<std::vector<CustomerData>> parts(num_chunks);
+    std::vector<std::uint32_t> part_rows(num_chunks);
+    std::vector<std::thread> threads;
+    for (std::size_t c = 1; c < num_chunks; c++) {
+        threads.emplace_back([&, c] {
+            part_rows[c] = parseCSVRange(bounds[c], bounds[c + 1], sortField, parts[c]);
+        });
+    }
+    part_rows[0] = parseCSVRange(bounds[0], bounds[1], sortField, parts[0]); // Thread saat ini ambil potongan pertama
+    for (auto &t : threads) t.join();
+
+    // Gabungkan hasil tiap thread sesuai urutan potongan, nomor baris dijadikan absolut
+    std::size_t total = 0;
+    for (auto &p : parts) total += p.size();
+    data_customers.reserve(data_customers.size() + total);
+    std::uint32_t first_row = 0;
+    for (std::size_t c = 0; c < num_chunks; c++) {
+        for (auto &item : parts[c]) item.row += first_row;
+        data_customers.insert(data_customers.end(), parts[c].begin(), parts[c].end());
+        first_row += part_rows[c];
+    }
+}
+
+// Fungsi membaca CSV: file di-map sekali lalu di-parse dengan parseCSV
+inline void readCSV(const std::string &filename, const std::string &sortField, std::vector<CustomerData> &data_customers)
+{
+    if (!csv_file.open(filename)) {
+        std::cerr << "[ERROR] Cannot open file: " << filename << "\n";
+        exit(1);
+    }
+    parseCSV(sortField, data_customers);
+}
+
+// Buat pasangan (sort_key, index) untuk mode key-index
+inline std::vector<KeyIndex> buildKeyIndex(const std::vector<CustomerData> &data_customers) {
+    std::vector<KeyIndex> keys(data_customers.size());
+    for (std::size_t i = 0; i < data_customers.size(); i++) {
+        keys[i] = {data_customers[i].sort_key, (std::uint32_t)i};
+    }
+    return keys;
+}
+
+// Jumlah record hasil sort (keys bisa berupa window yang lebih kecil dari data)
+inline std::size_t sortedCount(const std::vector<CustomerData> &data_customers, const std::vector<KeyIndex> *keys) {
+    return keys ? keys->size() : data_customers.size();
+}
+
+// Panggil visit(record) sesuai urutan hasil sort. Pada mode key-index urutan
+// diambil dari keys (permutasi diterapkan di sini, sekali saja).
+template <typename Visitor>
+inline void forEachSorted(const std::vector<CustomerData> &data_customers, const std::vector<KeyIndex> *keys, Visitor visit) {
+    if (keys) {
+        for (const auto &k : *keys) visit(data_customers[k.index]);
+    } else {
+        for (const auto &item : data_customers) visit(item);
+    }
+}
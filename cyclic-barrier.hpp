@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#endif
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Hint ke CPU bahwa thread sedang spin-wait (PAUSE di x86, YIELD di ARM)
+inline void cpuRelax() {
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    _mm_pause();
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// Pin thread saat ini ke satu core (core di-wrap dengan jumlah core yang ada).
+// Return false jika tidak didukung OS atau gagal.
+inline bool pinCurrentThread(int core) {
+    unsigned int cores = std::thread::hardware_concurrency();
+    if (cores == 0) return false;
+    core = core % (int)cores;
+#ifdef _WIN32
+    if (core >= 64) return false;
+    return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << core) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+// --- CyclicBarrier ---
+// Barrier sense-reversing berbasis atomic: thread yang datang lebih dulu
+// spin sebentar (cpuRelax) menunggu generation berganti, baru setelah
+// spin_limit putaran tidur di condition variable. Untuk pass yang pendek
+// hampir semua thread lolos di fase spin tanpa syscall sama sekali.
+class CyclicBarrier {
+private:
+    const int threshold;
+    const int spin_limit;
+    std::atomic<int> count;
+    std::atomic<unsigned> generation; // Berganti setiap barrier terbuka (sense)
+    int sleepers;                     // Jumlah thread yang tidur di cv (dijaga oleh m)
+    std::mutex m;
+    std::condition_variable cv;
+
+public:
+    explicit CyclicBarrier(int count, int spin_limit = 4096)
+        : threshold(count), spin_limit(spin_limit), count(count), generation(0), sleepers(0) {}
+
+    void await() {
+        unsigned gen = generation.load(std::memory_order_acquire);
+
+        if (count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            // Thread terakhir: reset count untuk putaran berikutnya lalu buka barrier
+            count.store(threshold, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(m); // Cegah lost wakeup dengan thread yang sedang masuk cv.wait
+            generation.store(gen + 1, std::memory_order_release);
+            if (sleepers > 0) cv.notify_all(); // Tanpa syscall jika semua thread masih spin
+            return;
+        }
+
+        // Fase spin: cukup untuk pass pendek
+        for (int i = 0; i < spin_limit; i++) {
+            if (generation.load(std::memory_order_acquire) != gen) return;
+            cpuRelax();
+        }
+
+        // Fase park: tidur sampai thread terakhir membuka barrier
+        std::unique_lock<std::mutex> lock(m);
+        sleepers++;
+        cv.wait(lock, [this, gen] { return generation.load(std::memory_order_acquire) != gen; });
+        sleepers--;
+    }
+};
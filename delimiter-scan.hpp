@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define DELIMITER_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+// ==========================================
+// SIMD Delimiter Scanning
+// ==========================================
+
+// Ukuran satu blok scan, satu bit per byte di dalam mask 64-bit
+const std::size_t SCAN_BLOCK = 64;
+
+// Hasil scan satu blok: bit i menyala jika block[i] adalah ',' atau '\n'
+struct DelimiterMask {
+    std::uint64_t commas;
+    std::uint64_t newlines;
+};
+
+// Posisi bit menyala terendah (mask tidak boleh 0)
+inline int lowestBit(std::uint64_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(mask);
+#else
+    int bit = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+// Kernel scan untuk tepat SCAN_BLOCK byte (dipilih sekali saat runtime)
+typedef DelimiterMask (*DelimiterKernel)(const char *block);
+
+// Versi scalar (fallback untuk CPU tanpa SSE4.2/AVX2 atau non-x86)
+inline DelimiterMask scanDelimitersScalar(const char *block) {
+    DelimiterMask mask = {0, 0};
+    for (std::size_t i = 0; i < SCAN_BLOCK; i++) {
+        mask.commas |= (std::uint64_t)(block[i] == ',') << i;
+        mask.newlines |= (std::uint64_t)(block[i] == '\n') << i;
+    }
+    return mask;
+}
+
+#ifdef DELIMITER_SCAN_X86
+
+// Versi SSE4.2: 4 x 16 byte per blok
+__attribute__((target("sse4.2")))
+inline DelimiterMask scanDelimitersSSE42(const char *block) {
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8('\n');
+    DelimiterMask mask = {0, 0};
+    for (int i = 0; i < 4; i++) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(block + i * 16));
+        mask.commas |= (std::uint64_t)(std::uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, comma)) << (i * 16);
+        mask.newlines |= (std::uint64_t)(std::uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, newline)) << (i * 16);
+    }
+    return mask;
+}
+
+// Versi AVX2: 2 x 32 byte per blok
+__attribute__((target("avx2")))
+inline DelimiterMask scanDelimitersAVX2(const char *block) {
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    __m256i lo = _mm256_loadu_si256((const __m256i *)block);
+    __m256i hi = _mm256_loadu_si256((const __m256i *)(block + 32));
+    DelimiterMask mask;
+    mask.commas = (std::uint64_t)(std::uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, comma)) |
+                  (std::uint64_t)(std::uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, comma)) << 32;
+    mask.newlines = (std::uint64_t)(std::uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, newline)) |
+                    (std::uint64_t)(std::uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, newline)) << 32;
+    return mask;
+}
+
+#endif
+
+// Pilih kernel terbaik yang didukung CPU (dicek sekali saja)
+inline DelimiterKernel selectDelimiterKernel() {
+#ifdef DELIMITER_SCAN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return scanDelimitersAVX2;
+    if (__builtin_cpu_supports("sse4.2")) return scanDelimitersSSE42;
+#endif
+    return scanDelimitersScalar;
+}
+
+inline const DelimiterKernel scanDelimiters = selectDelimiterKernel();
+
+// Scan [begin, end) per blok 64 byte dan panggil visit(block_offset, mask)
+// untuk setiap blok. Blok terakhir yang tidak penuh di-copy ke buffer lokal
+// (diisi 0) agar kernel tidak membaca di luar mapping.
+template <typename Visitor>
+inline void forEachDelimiterBlock(const char *begin, const char *end, Visitor visit) {
+    const char *p = begin;
+    for (; end - p >= (std::ptrdiff_t)SCAN_BLOCK; p += SCAN_BLOCK) {
+        visit((std::size_t)(p - begin), scanDelimiters(p));
+    }
+    if (p < end) {
+        char tail[SCAN_BLOCK] = {0};
+        std::memcpy(tail, p, (std::size_t)(end - p));
+        visit((std::size_t)(p - begin), scanDelimiters(tail));
+    }
+}
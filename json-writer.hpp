@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "csv-reader.hpp"
+
+// ==========================================
+// Streaming JSON Writer
+// ==========================================
+
+// Menulis JSON compact langsung ke buffer besar lalu fwrite per blok,
+// tanpa membangun DOM (nlohmann::json) untuk jutaan baris.
+class JsonWriter {
+private:
+    std::FILE *out;
+    std::vector<char> buffer;
+    std::size_t used;
+
+    void reserve(std::size_t n) {
+        if (used + n > buffer.size()) flush();
+    }
+
+public:
+    explicit JsonWriter(std::FILE *out = stdout, std::size_t capacity = 1 << 22)
+        : out(out), buffer(capacity), used(0) {}
+    ~JsonWriter() { flush(); }
+
+    JsonWriter(const JsonWriter &) = delete;
+    JsonWriter &operator=(const JsonWriter &) = delete;
+
+    void raw(char c) {
+        reserve(1);
+        buffer[used++] = c;
+    }
+
+    void raw(std::string_view s) {
+        if (s.empty()) return; // string_view kosong bisa ber-data() nullptr: memcpy(dst, nullptr, 0) UB
+        if (s.size() > buffer.size()) { // Terlalu besar untuk buffer: tulis langsung
+            flush();
+            std::fwrite(s.data(), 1, s.size(), out);
+            return;
+        }
+        reserve(s.size());
+        std::memcpy(buffer.data() + used, s.data(), s.size());
+        used += s.size();
+    }
+
+    // String JSON dengan tanda kutip; '"', '\\' dan karakter kontrol di-escape
+    void string(std::string_view s) {
+        static const char hex[] = "0123456789abcdef";
+        raw('"');
+        std::size_t start = 0;
+        for (std::size_t i = 0; i < s.size(); i++) {
+            unsigned char c = (unsigned char)s[i];
+            if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+            raw(s.substr(start, i - start)); // Bagian yang aman ditulis sekaligus
+            start = i + 1;
+            switch (c) {
+                case '"': raw("\\\""); break;
+                case '\\': raw("\\\\"); break;
+                case '\n': raw("\\n"); break;
+                case '\r': raw("\\r"); break;
+                case '\t': raw("\\t"); break;
+                case '\b': raw("\\b"); break;
+                case '\f': raw("\\f"); break;
+                default: {
+                    char esc[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 15]};
+                    raw(std::string_view(esc, 6));
+                }
+            }
+        }
+        raw(s.substr(start));
+        raw('"');
+    }
+
+    void number(long long value) {
+        char digits[24];
+        int n = std::snprintf(digits, sizeof(digits), "%lld", value);
+        raw(std::string_view(digits, (std::size_t)n));
+    }
+
+    void flush() {
+        if (used > 0) std::fwrite(buffer.data(), 1, used, out);
+        used = 0;
+        std::fflush(out);
+    }
+};
+
+// Tulis hasil sort dalam format yang dibaca app.py:
+//   ---START_JSON---
+//   {"duration":..,"data":[{"invoice_no":"..",...},...]}
+//   ---END_JSON---
+// Setiap field ditulis langsung dari span baris di csv_file (tanpa stringstream)
+inline void writeSortedJson(long long duration_ms, const std::vector<CustomerData> &data_customers,
+                            const std::vector<KeyIndex> *keys, std::FILE *out = stdout) {
+    // Prefix setiap field: {"invoice_no": lalu ,"customer_id": dst
+    std::string prefixes[NUM_COLUMNS];
+    for (int c = 0; c < NUM_COLUMNS; c++) {
+        prefixes[c] = std::string(c == 0 ? "{\"" : ",\"") + csv_columns[c] + "\":";
+    }
+
+    JsonWriter writer(out);
+    writer.raw("---START_JSON---\n{\"duration\":");
+    writer.number(duration_ms);
+    writer.raw(",\"data\":[");
+
+    bool first = true;
+    forEachSorted(data_customers, keys, [&](const CustomerData &item) {
+        if (!first) writer.raw(',');
+        first = false;
+
+        CsvTokenizer tokens(recordLine(item));
+        std::string_view field;
+        for (int c = 0; c < NUM_COLUMNS; c++) {
+            if (!tokens.next(field)) field = std::string_view();
+            writer.raw(prefixes[c]);
+            writer.string(field);
+        }
+        writer.raw('}');
+    });
+
+    writer.raw("]}\n---END_JSON---\n");
+}
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "csv-reader.hpp"
+#include "partial-sort.hpp"
+#include "simd-merge.hpp"
+#include "sort-options.hpp"
+#include "thread-pool.hpp"
+
+// ==========================================
+// Bagian Header (Modified for CustomerData)
+// ==========================================
+
+// Record bisa CustomerData atau KeyIndex (mode key-index), cukup punya sort_key
+template <typename Record>
+class ParallelMergeSort { 
+private:
+    std::vector<Record> *data; // Modified from vector<int> to vector<Record>
+    std::vector<Record> aux;   // Buffer bantu ukuran n, dialokasikan sekali di sort()
+    bool stable;               // Leaf memakai std::stable_sort (merge sudah stabil)
+    int prefix;                // Hanya prefix elemen pertama setiap run yang dibutuhkan (sortPrefix)
+
+    // Fungsi rekursif untuk melakukan merge sort
+    // available_threads menunjukkan berapa banyak thread yang bisa digunakan
+    // to_aux: hasil [left, right] yang terurut ditaruh di aux (true) atau di data (false).
+    // Kedua sisi di-sort ke buffer lawannya lalu di-merge ke tujuan (ping-pong per level)
+    void recursiveSort(int left, int right, int available_threads, bool to_aux);
+
+    // Merge src[left..mid] dan src[mid+1..right] ke dst[left..right]. Jika threads > 1
+    // output dibagi dengan merge path (co-ranking) sehingga level merge teratas juga paralel
+    void merge(Record *src, Record *dst, int left, int mid, int right, int threads);
+    static void mergeRange(Record *a, Record *a_end, Record *b, Record *b_end, Record *out);
+    // mergeRange, atau network SIMD untuk KeyIndex saat tidak mode stabil
+    void mergeRun(Record *a, Record *a_end, Record *b, Record *b_end, Record *out);
+    static int coRank(int k, const Record *a, int n_a, const Record *b, int n_b);
+
+public:
+    ParallelMergeSort(std::vector<Record> *data, bool stable = false); // Konstruktor
+    ~ParallelMergeSort(); // Destructor
+    
+    // Fungsi utama yang dipanggil user
+    void sort(); // Mulai proses sorting
+
+    // Hanya [0, end) yang dijamin terurut (untuk window --limit / --offset).
+    // Setiap merge berhenti setelah end output: elemen di posisi >= end dalam
+    // run-nya sudah punya end elemen di depannya, jadi tidak mungkin masuk prefix
+    void sortPrefix(int end);
+};
+
+// ==========================================
+// Bagian Implementasi (Modified for CustomerData)
+// ==========================================
+
+template <typename Record>
+ParallelMergeSort<Record>::ParallelMergeSort(std::vector<Record> *data, bool stable) // Konstruktor dengan
+    : data(data), stable(stable), prefix(0) { // Inisialisasi pointer ke data
+}
+
+template <typename Record>
+ParallelMergeSort<Record>::~ParallelMergeSort() {} // Destructor
+
+template <typename Record>
+void ParallelMergeSort<Record>::recursiveSort(int left, int right, int available_threads, bool to_aux) {
+    // Jika data kecil, urutkan langsung dengan std::sort (Sequential)
+    // Threshold 5000 digunakan untuk menyeimbangkan overhead thread
+    const int THRESHOLD = 5000; // Batas data untuk beralih ke sort sequential, 
+                                // jika data lebih kecil dari ini maka langsung gunakan std::sort
+    
+    if (right - left < THRESHOLD) { // Base case: gunakan std::sort untuk data kecil
+        // Modified: Use lambda to compare based on sort_key
+        auto byKey = [](const Record &a, const Record &b) {
+            return a.sort_key < b.sort_key;
+        };
+        if (stable) {
+            std::stable_sort(data->begin() + left, data->begin() + right + 1, byKey);
+        } else if constexpr (std::is_same<Record, KeyIndex>::value) {
+            // KeyIndex: sorting network + merge SIMD, aux[left..right] dipakai sebagai buffer sementara
+            sortKeyIndex(data->data() + left, data->data() + right + 1, aux.data() + left);
+        } else {
+            std::sort(data->begin() + left, data->begin() + right + 1, byKey);
+        }
+        if (to_aux) { // Level ini diminta menaruh hasil di buffer bantu
+            std::move(data->begin() + left, data->begin() + right + 1, aux.begin() + left);
+        }
+        return;
+    }
+
+    int mid = left + (right - left) / 2; // Cari titik tengah dari array
+                                         // titik tengah digunakan untuk membagi array
+
+    // Jika masih ada thread yang bisa dipakai (>1), pecah tugas ke thread pool
+    if (available_threads > 1) {
+        // Task baru di pool mengerjakan sisi kiri dengan setengah jumlah thread tersisa
+        TaskGroup group;
+        group.run([this, left, mid, available_threads, to_aux] { // this adalah pointer ke objek ParallelMergeSort, left dan mid adalah batas array
+            this->recursiveSort(left, mid, available_threads / 2, !to_aux); // Gunakan setengah thread untuk sisi kiri
+        });
+
+        // Thread saat ini (Current Thread) mengerjakan sisi kanan dengan sisa thread setelah dipakai kiri
+        this->recursiveSort(mid + 1, right, available_threads - (available_threads / 2), !to_aux); // Sisa thread untuk sisi kanan
+
+        // Tunggu task kiri selesai (sambil membantu task lain di pool)
+        group.wait(); // Menunggu sisi kiri selesai sebelum melanjutkan
+
+    } else {
+        // Jika thread tersedia sudah habis, jalankan rekursif biasa (single thread)
+        this->recursiveSort(left, mid, 1, !to_aux); // Hanya 1 thread untuk sisi kiri
+        this->recursiveSort(mid + 1, right, 1, !to_aux); // Hanya 1 thread untuk sisi kanan
+    }
+    
+    // Merge dua bagian yang sudah terurutkan dari buffer lawan ke buffer tujuan
+    // (paralel jika masih ada jatah thread), tanpa alokasi dan tanpa copy balik
+    Record *dst = to_aux ? aux.data() : data->data();
+    Record *src = to_aux ? data->data() : aux.data();
+    merge(src, dst, left, mid, right, available_threads);
+}
+
+// Merge sequential [a, a_end) dan [b, b_end) ke out. Stabil: key sama diambil dari kiri dulu
+template <typename Record>
+void ParallelMergeSort<Record>::mergeRange(Record *a, Record *a_end,
+                                           Record *b, Record *b_end, Record *out) {
+    while (a < a_end && b < b_end) {
+        if (a->sort_key <= b->sort_key) *out++ = std::move(*a++);
+        else *out++ = std::move(*b++);
+    }
+    out = std::move(a, a_end, out);
+    std::move(b, b_end, out);
+}
+
+template <typename Record>
+void ParallelMergeSort<Record>::mergeRun(Record *a, Record *a_end, Record *b, Record *b_end, Record *out) {
+    if constexpr (std::is_same<Record, KeyIndex>::value) {
+        if (!stable) {
+            mergeKeyIndex(a, a_end, b, b_end, out);
+            return;
+        }
+    }
+    mergeRange(a, a_end, b, b_end, out);
+}
+
+// Co-ranking (merge path): berapa elemen dari A yang masuk ke k elemen pertama
+// hasil merge A dan B. Binary search di sepanjang diagonal i + j = k
+template <typename Record>
+int ParallelMergeSort<Record>::coRank(int k, const Record *a, int n_a, const Record *b, int n_b) {
+    int lo = std::max(0, k - n_b);
+    int hi = std::min(k, n_a);
+    while (lo < hi) {
+        int i = lo + (hi - lo) / 2;
+        int j = k - i;
+        // a[i] <= b[j - 1]: a[i] masih harus keluar sebelum b[j - 1], ambil lebih banyak dari A
+        if (a[i].sort_key <= b[j - 1].sort_key) lo = i + 1;
+        else hi = i;
+    }
+    return lo;
+}
+
+template <typename Record>
+void ParallelMergeSort<Record>::merge(Record *src, Record *dst, int left, int mid, int right, int threads) {
+    const int PARALLEL_MERGE_MIN = 1 << 16; // Di bawah ini biaya task lebih besar dari merge-nya
+    // Run dan output dipotong ke prefix (sama dengan panjang penuh jika sort() biasa)
+    int n = std::min(right - left + 1, prefix);
+    Record *a = src + left;
+    Record *b = src + mid + 1;
+    int n_a = std::min(mid - left + 1, prefix);
+    int n_b = std::min(right - mid, prefix);
+
+    if (threads <= 1 || n < PARALLEL_MERGE_MIN) {
+        if (n == n_a + n_b) {
+            mergeRun(a, a + n_a, b, b + n_b, dst + left);
+        } else {
+            int i = coRank(n, a, n_a, b, n_b);
+            mergeRun(a, a + i, b, b + (n - i), dst + left);
+        }
+        return;
+    }
+
+    // Output dibagi rata menjadi potongan [k0, k1), co-rank di setiap batas
+    // menentukan potongan A dan B yang dibutuhkan, lalu setiap potongan di-merge
+    // oleh task sendiri tanpa sinkronisasi
+    std::vector<int> bound(threads + 1);
+    for (int t = 0; t <= threads; t++) bound[t] = (int)((long long)n * t / threads);
+
+    TaskGroup group;
+    for (int t = 0; t < threads; t++) {
+        group.run([this, t, a, b, n_a, n_b, dst, left, &bound] {
+            int k0 = bound[t], k1 = bound[t + 1];
+            int i0 = coRank(k0, a, n_a, b, n_b), i1 = coRank(k1, a, n_a, b, n_b);
+            mergeRun(a + i0, a + i1, b + (k0 - i0), b + (k1 - i1), dst + left + k0);
+        });
+    }
+    group.wait();
+}
+
+template <typename Record>
+void ParallelMergeSort<Record>::sort() {
+    sortPrefix(data ? (int)data->size() : 0);
+}
+
+template <typename Record>
+void ParallelMergeSort<Record>::sortPrefix(int end) {
+    if (!data || data->empty() || end <= 0) { // Cek jika data kosong
+        return;                               // Jika kosong, tidak perlu di-sort
+    }
+    prefix = end;
+
+    // Jumlah thread = ukuran thread pool (worker + thread pemanggil),
+    // pool dibuat sekali per proses berdasarkan std::thread::hardware_concurrency()
+    unsigned int cores = ThreadPool::instance().size();
+
+    // Satu buffer bantu untuk seluruh proses sort, bukan vector baru di setiap merge
+    aux.resize(data->size());
+
+    // Panggil fungsi rekursif dengan memberikan core yang tersedia, hasil akhir di data
+    recursiveSort(0, data->size() - 1, cores, false);  // Mulai dari indeks 0 sampai panjang size-1
+                                                       // size adalah variabel yang berisi jumlah elemen dalam vector
+
+    std::vector<Record>().swap(aux); // Lepas buffer bantu
+}
+
+// ==========================================
+// Bagian Entry Point (merge-sort.cpp & sort-server.cpp)
+// ==========================================
+
+// Sort records sesuai opsi: seluruh data, atau hanya window --limit / --offset
+// (records diganti isi window): leaf tetap di-sort penuh, tetapi setiap merge
+// hanya menghasilkan end output pertama (sortPrefix)
+template <typename Record>
+void runMergeSort(std::vector<Record> &records, const SortOptions &options) {
+    ParallelMergeSort<Record> sorter(&records, options.stable);
+    if (!options.hasWindow()) {
+        sorter.sort();
+        return;
+    }
+
+    std::size_t begin, end;
+    windowBounds(records.size(), options.offset, options.limit, begin, end);
+    if (begin < end) sorter.sortPrefix((int)end);
+    records = std::vector<Record>(records.begin() + begin, records.begin() + end);
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "csv-reader.hpp"
+#include "thread-pool.hpp"
+
+// ==========================================
+// Partial Sort (--limit / --offset)
+// ==========================================
+
+// Potong window [offset, offset + limit) ke dalam [0, n). limit < 0 berarti sampai akhir
+inline void windowBounds(std::size_t n, long long offset, long long limit, std::size_t &begin, std::size_t &end) {
+    begin = std::min<std::size_t>(n, (std::size_t)std::max(0LL, offset));
+    end = (limit < 0) ? n : begin + std::min<std::size_t>(n - begin, (std::size_t)limit);
+}
+
+// Ambil elemen hasil sort di posisi [begin, end) tanpa men-sort seluruh data:
+// 1. Data dibagi per thread, setiap bagian menaruh end elemen terkecilnya di
+//    depan dengan nth_element (O(n / P)) lalu menyalinnya sebagai kandidat.
+// 2. Di antara kandidat (maksimal P * end) dipilih end terkecil, lalu hanya
+//    window [begin, end) yang di-sort.
+// Urutan data ikut berubah. stable = true memakai tiebreak recordOrder() sehingga
+// hasilnya sama dengan potongan dari sort stabil.
+template <typename Record>
+inline std::vector<Record> selectWindow(std::vector<Record> &data, std::size_t begin, std::size_t end, bool stable) {
+    auto less = [stable](const Record &a, const Record &b) {
+        if (a.sort_key != b.sort_key) return a.sort_key < b.sort_key;
+        return stable && recordOrder(a) < recordOrder(b);
+    };
+
+    std::size_t n = data.size();
+    if (begin >= end) return std::vector<Record>();
+
+    // Tahap 1: kandidat per bagian, hanya jika jauh lebih kecil dari data
+    std::vector<Record> candidates;
+    std::vector<Record> *source = &data;
+    std::size_t parts = ThreadPool::instance().size();
+    if (parts > 1 && end * parts * 2 <= n) {
+        std::vector<std::size_t> bound(parts + 1);
+        for (std::size_t t = 0; t <= parts; t++) bound[t] = n * t / parts;
+        candidates.resize(end * parts);
+
+        TaskGroup group;
+        for (std::size_t t = 0; t < parts; t++) {
+            group.run([&, t] {
+                auto first = data.begin() + bound[t];
+                auto last = data.begin() + bound[t + 1];
+                std::size_t take = std::min<std::size_t>(end, bound[t + 1] - bound[t]);
+                if ((std::size_t)(last - first) > take) std::nth_element(first, first + take, last, less);
+                std::copy(first, first + take, candidates.begin() + t * end); // Slot bagian t
+            });
+        }
+        group.wait();
+
+        // Padatkan: buang slot kosong bagian yang lebih kecil dari end
+        std::size_t count = 0;
+        for (std::size_t t = 0; t < parts; t++) {
+            std::size_t take = std::min<std::size_t>(end, bound[t + 1] - bound[t]);
+            std::move(candidates.begin() + t * end, candidates.begin() + t * end + take, candidates.begin() + count);
+            count += take;
+        }
+        candidates.resize(count);
+        source = &candidates;
+    }
+
+    // Tahap 2: end elemen terkecil, lalu window [begin, end) saja yang di-sort
+    std::vector<Record> &c = *source;
+    if (end < c.size()) std::nth_element(c.begin(), c.begin() + end, c.end(), less);
+    if (begin > 0) std::nth_element(c.begin(), c.begin() + begin, c.begin() + end, less);
+    std::sort(c.begin() + begin, c.begin() + end, less);
+
+    return std::vector<Record>(c.begin() + begin, c.begin() + end);
+}
@@ -0,0 +1,91 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <random>
+#include <cstdint>
+#include "block-partition.hpp"
+
+// Benchmark satu pass partisi KeyIndex pada key 64-bit acak:
+// Lomuto (versi awal quick-sort), Dutch National Flag dan BlockQuicksort.
+
+// --- Global Variables ---
+const int length = 10000000;
+const int rounds = 5;
+
+// Partisi Lomuto: cabang "key < pivot" salah tebak ~50% pada data acak
+KeyIndex *lomutoPartition(KeyIndex *first, KeyIndex *last, long long pivot) {
+    KeyIndex *store = first;
+    for (KeyIndex *p = first; p < last; p++) {
+        if (p->sort_key < pivot) {
+            std::swap(*store, *p);
+            store++;
+        }
+    }
+    return store;
+}
+
+// Partisi three-way (Dutch National Flag), sama dengan ParallelQuickSort::partition
+KeyIndex *dnfPartition(KeyIndex *first, KeyIndex *last, long long pivot) {
+    KeyIndex *lt = first, *i = first, *gt = last - 1;
+    while (i <= gt) {
+        if (i->sort_key < pivot) {
+            std::swap(*lt++, *i++);
+        } else if (i->sort_key > pivot) {
+            std::swap(*i, *gt--);
+        } else {
+            i++;
+        }
+    }
+    return lt;
+}
+
+// Cek hasil partisi: [first, mid) < pivot dan [mid, last) >= pivot
+bool checkPartition(const std::vector<KeyIndex> &v, KeyIndex *mid, long long pivot) {
+    std::size_t m = (std::size_t)(mid - v.data());
+    for (std::size_t i = 0; i < v.size(); i++) {
+        if ((i < m) != (v[i].sort_key < pivot)) return false;
+    }
+    return true;
+}
+
+// Jalankan partisi beberapa kali pada salinan data yang sama, return waktu terbaik (ms)
+template <typename Partition>
+double benchmark(const char *name, const std::vector<KeyIndex> &source, long long pivot, Partition partition) {
+    double best = 1e18;
+    bool correct = true;
+    for (int r = 0; r < rounds; r++) {
+        std::vector<KeyIndex> v = source;
+        auto start_time = std::chrono::high_resolution_clock::now();
+        KeyIndex *mid = partition(v.data(), v.data() + v.size(), pivot);
+        auto end_time = std::chrono::high_resolution_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end_time - start_time).count());
+        if (!checkPartition(v, mid, pivot)) correct = false;
+    }
+    std::cout << name << " Millis: " << best << "ms" << (correct ? "" : "  (ERROR: wrong partition)") << std::endl;
+    return best;
+}
+
+int main() {
+    std::mt19937_64 rng(42);
+    std::vector<KeyIndex> source(length);
+    for (int i = 0; i < length; i++) {
+        source[i].sort_key = (long long)(rng() >> 1);
+        source[i].index = (std::uint32_t)i;
+    }
+
+    // Pivot = median, kasus terburuk untuk branch predictor
+    std::vector<long long> keys(length);
+    for (int i = 0; i < length; i++) keys[i] = source[i].sort_key;
+    std::nth_element(keys.begin(), keys.begin() + length / 2, keys.end());
+    long long pivot = keys[length / 2];
+
+    std::cout << "Partitioning " << length << " random 64-bit keys (best of " << rounds << ")..." << std::endl;
+    double lomuto = benchmark("Lomuto", source, pivot, lomutoPartition);
+    double dnf = benchmark("Dutch National Flag", source, pivot, dnfPartition);
+    double block = benchmark("BlockQuicksort", source, pivot, blockPartition<false>);
+
+    std::cout << "Speedup vs Lomuto: " << lomuto / block << "x" << std::endl;
+    std::cout << "Speedup vs Dutch National Flag: " << dnf / block << "x" << std::endl;
+    return 0;
+}
@@ -0,0 +1,431 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "block-partition.hpp"
+#include "csv-reader.hpp"
+#include "partial-sort.hpp"
+#include "sort-options.hpp"
+#include "thread-pool.hpp"
+
+// ==========================================
+// Bagian Header (ParallelQuickSort)
+// ==========================================
+
+// Record bisa CustomerData atau KeyIndex (mode key-index), cukup punya sort_key
+template <typename Record>
+class ParallelQuickSort { 
+private:
+    std::vector<Record> *data; 
+    int total; // Jumlah elemen seluruh array, untuk memperkirakan jatah thread per range
+    bool stable; // Key sama diurutkan ulang berdasarkan urutan file setelah sort
+    int window_lo, window_hi; // Hanya posisi [window_lo, window_hi) yang harus terurut
+
+    // Pilih pivot: ninther (median dari 3 median-of-3) yang tersebar di seluruh range
+    long long choosePivot(int low, int high);
+
+    // Helper untuk mempartisi array (Three-way / Dutch National Flag):
+    // [low, lt) < pivot, [lt, gt] == pivot, (gt, high] > pivot
+    void partition(int low, int high, long long pivot, int &lt, int &gt);
+
+    // Partisi paralel untuk range besar: setiap thread mempartisi satu blok,
+    // lalu elemen yang salah sisi ditukar secara paralel. Hasil [pred benar | pred salah]
+    template <typename Predicate>
+    int parallelPartition(int low, int high, Predicate pred, int threads);
+
+    // Cek cepat apakah range sudah terurut naik (return 1) atau turun (return -1).
+    // Berhenti di pelanggaran pertama, jadi murah untuk data acak
+    int detectOrder(int left, int right);
+
+    // Tukar beberapa elemen di posisi tetap agar pola input yang memancing
+    // partisi timpang (ala pdqsort) tidak berulang di level berikutnya
+    void breakPatterns(int left, int right);
+
+    // Fallback introsort: heapsort O(n log n) saat terlalu banyak partisi timpang
+    void heapSort(int left, int right);
+
+    // Fungsi rekursif untuk melakukan quick sort
+    // Subrange di atas THRESHOLD menjadi task yang bisa dicuri thread lain
+    // bad_allowed: sisa jatah partisi timpang sebelum beralih ke heapsort
+    void recursiveSort(int left, int right, int bad_allowed);
+
+    // Mode stabil: setiap run key yang sama di-sort dengan tiebreak recordOrder()
+    // (offset untuk CustomerData, index untuk KeyIndex). Run dibagi ke beberapa task
+    void orderTies();
+
+public:
+    ParallelQuickSort(std::vector<Record> *data, bool stable = false); // Konstruktor
+    ~ParallelQuickSort(); // Destructor
+    
+    // Fungsi utama yang dipanggil user
+    void sort(); // Mulai proses sorting
+
+    // Partial sort: hanya posisi [begin, end) yang dijamin terurut. Subrange di
+    // luar window tidak direkursi lagi (quickselect), jadi top-K menjadi O(n)
+    void sortWindow(int begin, int end);
+};
+
+// ==========================================
+// Bagian Implementasi (ParallelQuickSort)
+// ==========================================
+
+template <typename Record>
+ParallelQuickSort<Record>::ParallelQuickSort(std::vector<Record> *data, bool stable) // Konstruktor
+    : data(data), total(0), stable(stable), window_lo(0), window_hi(0) { 
+}
+
+template <typename Record>
+ParallelQuickSort<Record>::~ParallelQuickSort() {} // Destructor
+
+// Median dari tiga key
+inline long long medianOf3(long long a, long long b, long long c) {
+    if (a < b) return (b < c) ? b : (a < c ? c : a);
+    return (a < c) ? a : (b < c ? c : b);
+}
+
+// Pilih pivot dengan ninther (Tukey): median dari tiga median-of-3 di awal,
+// tengah dan akhir range. Jauh lebih tahan terhadap data terurut / berpola
+// dibanding elemen terakhir.
+template <typename Record>
+long long ParallelQuickSort<Record>::choosePivot(int low, int high) {
+    auto key = [this](int i) { return (*data)[i].sort_key; };
+    int mid = low + (high - low) / 2;
+    if (high - low < 40) return medianOf3(key(low), key(mid), key(high));
+
+    int step = (high - low) / 8;
+    long long m1 = medianOf3(key(low), key(low + step), key(low + 2 * step));
+    long long m2 = medianOf3(key(mid - step), key(mid), key(mid + step));
+    long long m3 = medianOf3(key(high - 2 * step), key(high - step), key(high));
+    return medianOf3(m1, m2, m3);
+}
+
+// Logika Partitioning (Dutch National Flag): satu pass memisahkan < pivot,
+// == pivot dan > pivot. Semua key yang sama dengan pivot langsung berada di
+// posisi akhirnya, jadi key dengan sedikit nilai unik (quantity, invoice_date)
+// tidak lagi membuat rekursi timpang/quadratic.
+//
+// Untuk KeyIndex (16 byte, key di depan) dipakai partisi branchless BlockQuicksort
+// dua kali: [< pivot | >= pivot], lalu sisi kanan [== pivot | > pivot].
+template <typename Record>
+void ParallelQuickSort<Record>::partition(int low, int high, long long pivot, int &lt, int &gt) {
+    if constexpr (std::is_same<Record, KeyIndex>::value) {
+        KeyIndex *first = data->data() + low;
+        KeyIndex *last = data->data() + high + 1;
+        KeyIndex *mid = blockPartition<false>(first, last, pivot);
+        KeyIndex *upper = blockPartition<true>(mid, last, pivot);
+        lt = (int)(mid - data->data());
+        gt = (int)(upper - data->data()) - 1;
+        return;
+    }
+
+    int i = low;
+    lt = low;  // Batas akhir bagian < pivot
+    gt = high; // Batas awal bagian > pivot
+
+    while (i <= gt) {
+        long long key = (*data)[i].sort_key;
+        if (key < pivot) {
+            std::swap((*data)[lt++], (*data)[i++]);
+        } else if (key > pivot) {
+            std::swap((*data)[i], (*data)[gt--]);
+        } else {
+            i++;
+        }
+    }
+}
+
+// Partisi paralel [low, high) menjadi [pred benar | pred salah]:
+// 1. Range dibagi menjadi blok, setiap thread mempartisi bloknya sendiri.
+// 2. Dari jumlah elemen "benar" diketahui titik batas akhir (split). Elemen "salah"
+//    di kiri split dan elemen "benar" di kanan split jumlahnya pasti sama.
+// 3. Pasangan elemen yang salah sisi itu dibagi rata ke semua thread lalu ditukar.
+template <typename Record>
+template <typename Predicate>
+int ParallelQuickSort<Record>::parallelPartition(int low, int high, Predicate pred, int threads) {
+    int n = high - low; // Elemen yang dipartisi: [low, high)
+    std::vector<int> block_start(threads + 1), block_mid(threads);
+    for (int t = 0; t <= threads; t++) block_start[t] = low + (int)((long long)n * t / threads);
+
+    // Tahap 1: partisi lokal per blok
+    {
+        TaskGroup group;
+        for (int t = 0; t < threads; t++) {
+            group.run([this, t, &pred, &block_start, &block_mid] {
+                auto first = data->begin() + block_start[t];
+                auto last = data->begin() + block_start[t + 1];
+                auto mid = std::partition(first, last, pred);
+                block_mid[t] = (int)(mid - data->begin());
+            });
+        }
+        group.wait();
+    }
+
+    // Tahap 2: cari elemen yang salah sisi terhadap split
+    int split = low;
+    for (int t = 0; t < threads; t++) split += block_mid[t] - block_start[t];
+
+    struct Interval { int begin, end; };
+    std::vector<Interval> wrong_left;  // Elemen "salah" yang berada di kiri split
+    std::vector<Interval> wrong_right; // Elemen "benar" yang berada di kanan split
+    int misplaced = 0;
+    for (int t = 0; t < threads; t++) {
+        int b = block_mid[t], e = std::min(block_start[t + 1], split);
+        if (b < e) { wrong_left.push_back({b, e}); misplaced += e - b; }
+        b = std::max(block_start[t], split), e = block_mid[t];
+        if (b < e) wrong_right.push_back({b, e});
+    }
+
+    // Tahap 3: tukar pasangan salah sisi, potongan ke-k dari daftar kiri dengan potongan ke-k dari daftar kanan
+    if (misplaced > 0) {
+        // Cari posisi ke-offset di dalam daftar interval
+        auto locate = [](const std::vector<Interval> &list, int offset, size_t &idx, int &pos) {
+            idx = 0;
+            while (offset >= list[idx].end - list[idx].begin) {
+                offset -= list[idx].end - list[idx].begin;
+                idx++;
+            }
+            pos = list[idx].begin + offset;
+        };
+
+        TaskGroup group;
+        for (int t = 0; t < threads; t++) {
+            int from = (int)((long long)misplaced * t / threads);
+            int to = (int)((long long)misplaced * (t + 1) / threads);
+            if (from == to) continue;
+            group.run([this, from, to, &wrong_left, &wrong_right, &locate] {
+                size_t li, ri;
+                int lp, rp;
+                locate(wrong_left, from, li, lp);
+                locate(wrong_right, from, ri, rp);
+                for (int k = from; k < to; k++) {
+                    std::swap((*data)[lp], (*data)[rp]);
+                    if (++lp == wrong_left[li].end && ++li < wrong_left.size()) lp = wrong_left[li].begin;
+                    if (++rp == wrong_right[ri].end && ++ri < wrong_right.size()) rp = wrong_right[ri].begin;
+                }
+            });
+        }
+        group.wait();
+    }
+
+    return split; // Kembalikan batas [pred benar | pred salah]
+}
+
+template <typename Record>
+int ParallelQuickSort<Record>::detectOrder(int left, int right) {
+    bool ascending = true, descending = true;
+    for (int i = left; i < right && (ascending || descending); i++) {
+        long long a = (*data)[i].sort_key, b = (*data)[i + 1].sort_key;
+        if (a > b) ascending = false;
+        if (a < b) descending = false;
+    }
+    if (ascending) return 1;
+    if (descending) return -1;
+    return 0;
+}
+
+template <typename Record>
+void ParallelQuickSort<Record>::breakPatterns(int left, int right) {
+    int size = right - left + 1;
+    if (size < 8) return;
+    int quarter = size / 4;
+    std::swap((*data)[left], (*data)[left + quarter]);
+    std::swap((*data)[right], (*data)[right - quarter]);
+    int mid = left + size / 2;
+    std::swap((*data)[mid - 1], (*data)[left + quarter + 1]);
+    std::swap((*data)[mid + 1], (*data)[right - quarter - 1]);
+}
+
+template <typename Record>
+void ParallelQuickSort<Record>::heapSort(int left, int right) {
+    auto cmp = [](const Record &a, const Record &b) { return a.sort_key < b.sort_key; };
+    std::make_heap(data->begin() + left, data->begin() + right + 1, cmp);
+    std::sort_heap(data->begin() + left, data->begin() + right + 1, cmp);
+}
+
+template <typename Record>
+void ParallelQuickSort<Record>::recursiveSort(int left, int right, int bad_allowed) {
+    // Jika data kecil, urutkan langsung dengan std::sort (Sequential)
+    // Threshold 5000 digunakan untuk menyeimbangkan overhead thread
+    const int THRESHOLD = 100000; 
+    
+    // Base case: jika range tidak valid atau di luar window partial sort
+    if (left >= right) return;
+    if (right < window_lo || left >= window_hi) return;
+
+    if (right - left < THRESHOLD) { 
+        auto cmp = [](const Record &a, const Record &b) {
+            return a.sort_key < b.sort_key;
+        };
+        // Window hanya menutupi sebagian range: pilih batasnya dulu, sort isinya saja
+        auto first = data->begin() + std::max(left, window_lo);
+        auto last = data->begin() + std::min(right + 1, window_hi);
+        if (last < data->begin() + right + 1) std::nth_element(data->begin() + left, last, data->begin() + right + 1, cmp);
+        if (first > data->begin() + left) std::nth_element(data->begin() + left, first, last, cmp);
+        std::sort(first, last, cmp); 
+        return;
+    }
+
+    // Short-circuit untuk input yang sudah terurut (export CSV sering sudah
+    // urut invoice_no) atau terurut terbalik: O(n), tanpa partisi
+    int order = detectOrder(left, right);
+    if (order == 1) return;
+    if (order == -1) {
+        std::reverse(data->begin() + left, data->begin() + right + 1);
+        return;
+    }
+
+    // Depth guard: terlalu banyak partisi timpang -> heapsort, tetap O(n log n)
+    if (bad_allowed <= 0) {
+        heapSort(left, right);
+        return;
+    }
+
+    // Range besar di level atas: partisi paralel dengan jatah thread sebanding
+    // ukuran range, agar level pertama tidak menjadi O(n) serial
+    const int PARALLEL_PARTITION_MIN = 1 << 18;
+    int threads = (int)((long long)ThreadPool::instance().size() * (right - left + 1) / total);
+
+    // Lakukan partisi 3 arah: elemen < pivot ke kiri, == pivot di tengah, > pivot ke kanan
+    long long pivot = choosePivot(left, right);
+    int lt, gt;
+    if (threads > 1 && right - left >= PARALLEL_PARTITION_MIN) {
+        // Versi paralel: dua pass, pertama pisahkan < pivot, lalu == pivot dari sisanya
+        lt = parallelPartition(left, right + 1, [pivot](const Record &r) { return r.sort_key < pivot; }, threads);
+        gt = parallelPartition(lt, right + 1, [pivot](const Record &r) { return r.sort_key == pivot; }, threads) - 1;
+    } else {
+        partition(left, right, pivot, lt, gt);
+    }
+
+    // Partisi timpang (sisi terbesar > 7/8 range): kurangi jatah dan acak
+    // sedikit kedua sisi agar pola yang sama tidak terulang
+    int size = right - left + 1;
+    int left_size = lt - left, right_size = right - gt;
+    if (std::max(left_size, right_size) > size - size / 8) {
+        bad_allowed--;
+        breakPatterns(left, lt - 1);
+        breakPatterns(gt + 1, right);
+    }
+
+    // --- LOGIKA UTAMA PARALLEL ---
+
+    // Sisi kiri pivot (left ... lt-1) menjadi task di deque thread ini. Jika ada
+    // thread yang menganggur, task ini dicuri; jika tidak, thread ini sendiri
+    // yang mengerjakannya saat wait(). Jadi pivot yang timpang tidak membuat
+    // thread lain menganggur seperti pembagian jatah thread per level.
+    // Bagian == pivot (lt ... gt) sudah di posisi akhir dan tidak perlu disentuh lagi.
+    TaskGroup group;
+    group.run([this, left, lt, bad_allowed] {
+        this->recursiveSort(left, lt - 1, bad_allowed);
+    });
+
+    // Thread saat ini (Current Thread) mengerjakan sisi kanan pivot (gt+1 ... right)
+    this->recursiveSort(gt + 1, right, bad_allowed);
+
+    // Tunggu task kiri selesai (sambil membantu/mencuri task lain di pool)
+    group.wait();
+}
+
+template <typename Record>
+void ParallelQuickSort<Record>::sort() {
+    if (!data || data->empty()) {
+        return;
+    }
+
+    total = (int)data->size();
+    window_lo = 0;
+    window_hi = total;
+
+    // Jatah partisi timpang = log2(n), seperti batas kedalaman introsort/pdqsort
+    int bad_allowed = 0;
+    for (int n = total; n > 1; n >>= 1) bad_allowed++;
+
+    // Panggil fungsi rekursif, thread pool (dibuat sekali per proses) membagi kerja
+    recursiveSort(0, data->size() - 1, bad_allowed);  
+
+    if (stable) orderTies();
+}
+
+template <typename Record>
+void ParallelQuickSort<Record>::sortWindow(int begin, int end) {
+    if (!data || data->empty() || begin >= end) {
+        return;
+    }
+
+    total = (int)data->size();
+    window_lo = begin;
+    window_hi = end;
+
+    int bad_allowed = 0;
+    for (int n = total; n > 1; n >>= 1) bad_allowed++;
+
+    recursiveSort(0, data->size() - 1, bad_allowed);
+}
+
+template <typename Record>
+void ParallelQuickSort<Record>::orderTies() {
+    // Potong array menjadi beberapa bagian, batas digeser ke awal run key
+    // berikutnya agar satu run tidak pernah terbelah antar task. Data sudah
+    // urut per key, jadi akhir run dicari dengan upper_bound (O(log n)), bukan
+    // maju satu per satu di thread pemanggil
+    int parts = (int)ThreadPool::instance().size() * 4;
+    std::vector<int> bound(parts + 1);
+    for (int t = 0; t <= parts; t++) {
+        int b = (int)((long long)total * t / parts);
+        if (t > 0) b = std::max(b, bound[t - 1]);
+        if (b > 0 && b < total && (*data)[b].sort_key == (*data)[b - 1].sort_key) {
+            long long key = (*data)[b - 1].sort_key;
+            auto it = std::upper_bound(data->begin() + b, data->end(), key,
+                                       [](long long k, const Record &r) { return k < r.sort_key; });
+            b = (int)(it - data->begin());
+        }
+        bound[t] = b;
+    }
+
+    TaskGroup group;
+    for (int t = 0; t < parts; t++) {
+        if (bound[t] == bound[t + 1]) continue;
+        group.run([this, t, &bound] {
+            int i = bound[t];
+            while (i < bound[t + 1]) {
+                int j = i + 1;
+                while (j < bound[t + 1] && (*data)[j].sort_key == (*data)[i].sort_key) j++;
+                if (j - i > 1) {
+                    std::sort(data->begin() + i, data->begin() + j, [](const Record &a, const Record &b) {
+                        return recordOrder(a) < recordOrder(b);
+                    });
+                }
+                i = j;
+            }
+        });
+    }
+    group.wait();
+}
+
+// ==========================================
+// Bagian Entry Point (quick-sort.cpp & sort-server.cpp)
+// ==========================================
+
+// Sort records sesuai opsi: seluruh data, atau hanya window --limit / --offset
+// (records diganti isi window). Mode stabil memakai selectWindow karena key
+// yang sama dengan batas window bisa tersebar di luar window
+template <typename Record>
+void runQuickSort(std::vector<Record> &records, const SortOptions &options) {
+    ParallelQuickSort<Record> sorter(&records, options.stable);
+    if (!options.hasWindow()) {
+        sorter.sort();
+        return;
+    }
+
+    std::size_t begin, end;
+    windowBounds(records.size(), options.offset, options.limit, begin, end);
+    if (options.stable) {
+        records = selectWindow(records, begin, end, true);
+    } else {
+        sorter.sortWindow((int)begin, (int)end);
+        records = std::vector<Record>(records.begin() + begin, records.begin() + end);
+    }
+}
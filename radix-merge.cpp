@@ -1,43 +1,16 @@
 #include <iostream>
 #include <vector>
 #include <thread>
-#include <mutex>
-#include <condition_variable>
 #include <chrono>
 #include <algorithm>
 #include <random>
+#include "cyclic-barrier.hpp"
 
 // --- Global Variables (mirip static di Java) ---
 const int length = 10-000-000;
 std::vector<short> data3(length);
 const int numThreads = 4;
 
-// --- Implementasi CyclicBarrier untuk C++ ---
-class CyclicBarrier {
-private:
-    std::mutex m;
-    std::condition_variable cv;
-    int threshold;
-    int count;
-    int generation;
-
-public:
-    explicit CyclicBarrier(int count) : threshold(count), count(count), generation(0) {}
-
-    void await() {
-        std::unique_lock<std::mutex> lock(m);
-        int gen = generation;
-
-        if (--count == 0) {
-            generation++;
-            count = threshold;
-            cv.notify_all();
-        } else {
-            cv.wait(lock, [this, gen] { return gen != generation; });
-        }
-    }
-};
-
 // --- Helper Functions ---
 
 // Mencari nilai maksimum di range tertentu
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "csv-reader.hpp"
+#include "cyclic-barrier.hpp"
+#include "partial-sort.hpp"
+#include "sort-options.hpp"
+
+// ==========================================
+// Bagian Header (ParallelRadixSort)
+// ==========================================
+
+// LSD radix sort: setiap thread menghitung histogram potongannya, thread 0
+// menghitung posisi awal per (bucket, thread), lalu semua thread scatter.
+// Record bisa CustomerData atau KeyIndex (mode key-index), cukup punya sort_key
+template <typename Record>
+class ParallelRadixSort {
+private:
+    std::vector<Record> *data;
+    std::vector<Record> buffer; // Buffer ping-pong ukuran n, dialokasikan di sort()
+    int length;
+    int numThreads;
+
+    // Radix berbasis bit: digit diambil dengan shift & mask, bukan / dan % 10
+    int radixBits;  // Lebar digit (8 = base-256, bisa 11 atau 16)
+    int numBuckets; // Jumlah bucket per pass
+
+    std::vector<std::vector<int>> global_counts; // [numThreads][numBuckets]
+    std::vector<std::vector<int>> global_starts; // [numBuckets][numThreads]
+
+    // Diset thread 0 jika semua key punya digit yang sama pada pass ini,
+    // sehingga semua thread bisa melewati scatter & copy-back bersama-sama.
+    bool skipPass;
+
+    // --pin: setiap worker di-pin ke core myID
+    bool pinThreads;
+
+    // Key digeser ke (sort_key - minVal) agar selalu unsigned dan sesempit mungkin:
+    // YYYYMMDD dalam rentang beberapa tahun cukup 2 pass 8-bit.
+    unsigned long long radixDigit(long long key, long long minVal, int shift) const {
+        return ((unsigned long long)(key - minVal) >> shift) & (unsigned long long)(numBuckets - 1);
+    }
+
+    // --- Worker Thread ---
+    void threadWorker(int myID, CyclicBarrier &barrier, long long minVal, long long maxVal);
+
+public:
+    ParallelRadixSort(std::vector<Record> *data, int radix_bits = 8, bool pin_threads = false);
+
+    // Sort seluruh data (selalu stabil)
+    void sort();
+
+    // Window --limit / --offset: data diganti isi posisi [begin, end) hasil sort.
+    // Satu pass MSD menghitung histogram digit teratas, hanya record di bucket
+    // yang beririsan dengan window dikumpulkan (urutan asli tetap, jadi tetap
+    // stabil) lalu di-sort dengan sort() biasa
+    void sortWindow(int begin, int end);
+};
+
+// Get min & max key
+template <typename Record>
+void getMinMax(const std::vector<Record> &data, long long &mn, long long &mx) {
+    mn = mx = 0;
+    if (data.empty()) return;
+    mn = mx = data[0].sort_key;
+    for (auto &x : data) {
+        if (x.sort_key < mn) mn = x.sort_key;
+        if (x.sort_key > mx) mx = x.sort_key;
+    }
+}
+
+// ==========================================
+// Bagian Implementasi (ParallelRadixSort)
+// ==========================================
+
+template <typename Record>
+ParallelRadixSort<Record>::ParallelRadixSort(std::vector<Record> *data, int radix_bits, bool pin_threads)
+    : data(data), length(0), numThreads(std::max(1, (int)std::thread::hardware_concurrency())),
+      radixBits(radix_bits), numBuckets(1 << radix_bits), skipPass(false), pinThreads(pin_threads) {
+}
+
+template <typename Record>
+void ParallelRadixSort<Record>::threadWorker(int myID, CyclicBarrier &barrier, long long minVal, long long maxVal)
+{
+    if (pinThreads) pinCurrentThread(myID);
+
+    int rowsPerThread = length / numThreads;
+    int start = myID * rowsPerThread;
+    int end = (myID == numThreads - 1) ? length : start + rowsPerThread;
+
+    unsigned long long range = (unsigned long long)(maxVal - minVal);
+    std::vector<int> my_indices(numBuckets);
+
+    // Ping-pong: src dan dst bergantian antara data dan buffer setiap pass,
+    // jadi tidak ada pass copy-back (dan barrier tambahannya) per digit.
+    Record *src = data->data();
+    Record *dst = buffer.data();
+
+    for (int shift = 0; shift < 64 && (range >> shift) > 0; shift += radixBits) {
+
+        for (int i = 0; i < numBuckets; i++)
+            global_counts[myID][i] = 0;
+
+        for (int i = start; i < end; i++) {
+            int digit = (int)radixDigit(src[i].sort_key, minVal, shift);
+            global_counts[myID][digit]++;
+        }
+        barrier.await();
+
+        if (myID == 0) {
+            int total = 0;
+            skipPass = false;
+            for (int d = 0; d < numBuckets; d++) {
+                int bucket_start = total;
+                for (int t = 0; t < numThreads; t++) {
+                    global_starts[d][t] = total;
+                    total += global_counts[t][d];
+                }
+                if (total - bucket_start == length) skipPass = true; // Satu bucket berisi semua data
+            }
+        }
+        barrier.await();
+
+        // Pass trivial: urutan tidak berubah, lanjut ke digit berikutnya
+        if (skipPass) continue;
+
+        for (int d = 0; d < numBuckets; d++)
+            my_indices[d] = global_starts[d][myID];
+
+        for (int i = start; i < end; i++) {
+            int digit = (int)radixDigit(src[i].sort_key, minVal, shift);
+            dst[my_indices[digit]++] = src[i];
+        }
+        barrier.await();
+
+        std::swap(src, dst);
+    }
+
+    // Jumlah pass ganjil: hasil akhir ada di buffer, salin sekali ke data
+    if (src != data->data()) {
+        for (int i = start; i < end; i++)
+            (*data)[i] = src[i];
+    }
+}
+
+template <typename Record>
+void ParallelRadixSort<Record>::sort() {
+    if (!data || data->empty()) {
+        return;
+    }
+
+    length = (int)data->size();
+    buffer.resize(length);
+
+    // Siapkan global_counts: [numThreads][numBuckets] dan global_starts: [numBuckets][numThreads], isi 0
+    global_counts.assign(numThreads, std::vector<int>(numBuckets, 0));
+    global_starts.assign(numBuckets, std::vector<int>(numThreads, 0));
+
+    long long mn, mx;
+    getMinMax(*data, mn, mx);
+    CyclicBarrier barrier(numThreads);
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < numThreads; i++)
+        threads.emplace_back(&ParallelRadixSort::threadWorker, this, i, std::ref(barrier), mn, mx);
+
+    for (auto &t : threads)
+        t.join();
+
+    std::vector<Record>().swap(buffer); // Lepas buffer ping-pong
+}
+
+template <typename Record>
+void ParallelRadixSort<Record>::sortWindow(int begin, int end) {
+    if (!data) return;
+    if (begin >= end) {
+        data->clear();
+        return;
+    }
+
+    // Digit teratas dari (sort_key - minVal): radixBits bit paling atas rentang key
+    long long mn, mx;
+    getMinMax(*data, mn, mx);
+    unsigned long long range = (unsigned long long)(mx - mn);
+    int top = 0;
+    while (top < 64 && (range >> top) > 0) top++;
+    int shift = std::max(0, top - radixBits);
+
+    std::vector<int> counts(numBuckets, 0);
+    for (const Record &r : *data)
+        counts[radixDigit(r.sort_key, mn, shift)]++;
+
+    // Bucket pertama & terakhir yang beririsan dengan [begin, end)
+    int lo = 0, skipped = 0;
+    while (skipped + counts[lo] <= begin) skipped += counts[lo++];
+    int hi = lo, reach = skipped + counts[lo];
+    while (reach < end) reach += counts[++hi];
+
+    // Kumpulkan kandidat, kecuali semua data jatuh di bucket tersebut
+    if (reach - skipped < (int)data->size()) {
+        std::vector<Record> candidates;
+        candidates.reserve(reach - skipped);
+        for (const Record &r : *data) {
+            int digit = (int)radixDigit(r.sort_key, mn, shift);
+            if (digit >= lo && digit <= hi) candidates.push_back(r);
+        }
+        data->swap(candidates);
+    } else {
+        skipped = 0;
+    }
+
+    sort();
+    *data = std::vector<Record>(data->begin() + (begin - skipped), data->begin() + (end - skipped));
+}
+
+// ==========================================
+// Bagian Entry Point (radix-sort.cpp & sort-server.cpp)
+// ==========================================
+
+// --stable tidak perlu kerja tambahan: LSD radix dengan scatter per thread
+// berurutan (thread i menulis setelah thread i-1 di setiap bucket) sudah stabil.
+// Window --limit / --offset memakai sortWindow (pass MSD lalu LSD pada bucket
+// yang dibutuhkan saja), --radix-bits dan --pin tetap berlaku
+template <typename Record>
+void runRadixSort(std::vector<Record> &records, const SortOptions &options) {
+    ParallelRadixSort<Record> sorter(&records, options.radix_bits, options.pin_threads);
+    if (!options.hasWindow()) {
+        sorter.sort();
+        return;
+    }
+
+    std::size_t begin, end;
+    windowBounds(records.size(), options.offset, options.limit, begin, end);
+    sorter.sortWindow((int)begin, (int)end);
+}
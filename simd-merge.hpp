@@ -0,0 +1,297 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+#include "csv-reader.hpp"
+
+// Hanya x86-64: di i386 long long di dalam struct cukup align 4, jadi KeyIndex
+// 12 byte dan tidak mengisi tepat satu lane 128-bit
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SIMD_MERGE_X86 1
+#include <immintrin.h>
+#endif
+
+// ==========================================
+// SIMD Sorting/Merging Network (KeyIndex)
+// ==========================================
+
+// KeyIndex = 16 byte (sort_key 64-bit + index), jadi satu lane 128-bit berisi
+// satu elemen: 2 elemen per register AVX2, 4 elemen per register AVX-512.
+// Compare-exchange membandingkan qword key lalu menyalin mask ke seluruh lane,
+// sehingga index ikut berpindah bersama key-nya.
+//
+// Merge dengan network bitonic TIDAK stabil (urutan key sama dari kiri/kanan
+// bisa tertukar), jadi hanya dipakai saat --stable tidak aktif.
+
+// Kernel merge [a, a_end) dan [b, b_end) ke out (dipilih sekali saat runtime)
+typedef void (*KeyIndexMergeKernel)(const KeyIndex *a, const KeyIndex *a_end,
+                                    const KeyIndex *b, const KeyIndex *b_end, KeyIndex *out);
+
+// Kernel sort tepat 8 elemen di tempat
+typedef void (*KeyIndexBlockKernel)(KeyIndex *block);
+
+const int KEY_INDEX_BLOCK = 8;
+
+// Versi scalar (fallback untuk CPU tanpa AVX2 atau non-x86)
+inline void mergeKeyIndexScalar(const KeyIndex *a, const KeyIndex *a_end,
+                                const KeyIndex *b, const KeyIndex *b_end, KeyIndex *out) {
+    while (a < a_end && b < b_end) {
+        if (a->sort_key <= b->sort_key) *out++ = *a++;
+        else *out++ = *b++;
+    }
+    out = std::copy(a, a_end, out);
+    std::copy(b, b_end, out);
+}
+
+inline void sortKeyIndexBlockScalar(KeyIndex *block) {
+    std::sort(block, block + KEY_INDEX_BLOCK, [](const KeyIndex &x, const KeyIndex &y) {
+        return x.sort_key < y.sort_key;
+    });
+}
+
+// Sisa setelah loop SIMD: carry (register terakhir, terurut) + sisa a + sisa b.
+// Salah satu sisa pasti lebih pendek dari satu register, gabungkan dulu dengan
+// carry di buffer kecil lalu merge dengan sisa yang panjang
+inline void mergeKeyIndexTail(const KeyIndex *carry, int carry_count,
+                              const KeyIndex *a, const KeyIndex *a_end,
+                              const KeyIndex *b, const KeyIndex *b_end, KeyIndex *out) {
+    if (a_end - a > b_end - b) {
+        std::swap(a, b);
+        std::swap(a_end, b_end);
+    }
+    KeyIndex small[4 * KEY_INDEX_BLOCK];
+    KeyIndex *small_end = small + carry_count + (a_end - a);
+    mergeKeyIndexScalar(carry, carry + carry_count, a, a_end, small);
+    mergeKeyIndexScalar(small, small_end, b, b_end, out);
+}
+
+#ifdef SIMD_MERGE_X86
+
+static_assert(sizeof(KeyIndex) == 16, "Kernel SIMD mengasumsikan satu KeyIndex = satu lane 128-bit");
+
+// --- AVX2: 2 elemen per register ---
+
+// Min ke a, max ke b (per lane)
+__attribute__((target("avx2")))
+inline void compareSwapAVX2(__m256i &a, __m256i &b) {
+    __m256i gt = _mm256_cmpgt_epi64(a, b);
+    gt = _mm256_shuffle_epi32(gt, _MM_SHUFFLE(1, 0, 1, 0)); // Mask key -> seluruh lane
+    __m256i mn = _mm256_blendv_epi8(a, b, gt);
+    b = _mm256_blendv_epi8(b, a, gt);
+    a = mn;
+}
+
+// Urutkan 2 elemen di dalam satu register (jarak 1). Keputusan tukar diambil
+// dari lane 0 saja dan berlaku untuk kedua lane, agar key yang sama tidak
+// menghasilkan elemen kembar
+__attribute__((target("avx2")))
+inline __m256i sortLanesAVX2(__m256i x) {
+    __m256i y = _mm256_permute2x128_si256(x, x, 0x01);
+    __m256i swap = _mm256_permute4x64_epi64(_mm256_cmpgt_epi64(x, y), 0x00);
+    return _mm256_blendv_epi8(x, y, swap);
+}
+
+// Merge bitonic 4 + 4: input (a0, a1) dan (b0, b1) masing-masing terurut,
+// output 4 terkecil di (a0, a1), 4 terbesar di (b0, b1)
+__attribute__((target("avx2")))
+inline void bitonicMerge4AVX2(__m256i &a0, __m256i &a1, __m256i &b0, __m256i &b1) {
+    __m256i r0 = _mm256_permute2x128_si256(b1, b1, 0x01); // B dibalik: barisan bitonic
+    __m256i r1 = _mm256_permute2x128_si256(b0, b0, 0x01);
+    compareSwapAVX2(a0, r0); // Jarak 4
+    compareSwapAVX2(a1, r1);
+    compareSwapAVX2(a0, a1); // Jarak 2
+    compareSwapAVX2(r0, r1);
+    a0 = sortLanesAVX2(a0);  // Jarak 1
+    a1 = sortLanesAVX2(a1);
+    b0 = sortLanesAVX2(r0);
+    b1 = sortLanesAVX2(r1);
+}
+
+__attribute__((target("avx2")))
+inline __m256i loadPairAVX2(const KeyIndex *p) { return _mm256_loadu_si256((const __m256i *)p); }
+
+__attribute__((target("avx2")))
+inline void storePairAVX2(KeyIndex *p, __m256i v) { _mm256_storeu_si256((__m256i *)p, v); }
+
+__attribute__((target("avx2")))
+inline void mergeKeyIndexAVX2(const KeyIndex *a, const KeyIndex *a_end,
+                              const KeyIndex *b, const KeyIndex *b_end, KeyIndex *out) {
+    if (a_end - a < 4 || b_end - b < 4) {
+        mergeKeyIndexScalar(a, a_end, b, b_end, out);
+        return;
+    }
+
+    __m256i lo0 = loadPairAVX2(a), lo1 = loadPairAVX2(a + 2);
+    __m256i hi0 = loadPairAVX2(b), hi1 = loadPairAVX2(b + 2);
+    a += 4;
+    b += 4;
+
+    while (true) {
+        bitonicMerge4AVX2(lo0, lo1, hi0, hi1);
+        storePairAVX2(out, lo0);
+        storePairAVX2(out + 2, lo1);
+        out += 4;
+
+        // Ambil 4 elemen berikutnya dari sisi yang head-nya lebih kecil
+        if (a_end - a < 4 || b_end - b < 4) break;
+        const KeyIndex *&src = (a->sort_key <= b->sort_key) ? a : b;
+        lo0 = loadPairAVX2(src);
+        lo1 = loadPairAVX2(src + 2);
+        src += 4;
+    }
+
+    KeyIndex carry[4];
+    storePairAVX2(carry, hi0);
+    storePairAVX2(carry + 2, hi1);
+    mergeKeyIndexTail(carry, 4, a, a_end, b, b_end, out);
+}
+
+// Sort 8 elemen: network 4 elemen dijalankan per kolom pada 4 register
+// (2 kolom sekaligus), transpose menjadi 2 run isi 4, lalu merge bitonic
+__attribute__((target("avx2")))
+inline void sortKeyIndexBlockAVX2(KeyIndex *block) {
+    __m256i r0 = loadPairAVX2(block), r1 = loadPairAVX2(block + 2);
+    __m256i r2 = loadPairAVX2(block + 4), r3 = loadPairAVX2(block + 6);
+
+    compareSwapAVX2(r0, r1);
+    compareSwapAVX2(r2, r3);
+    compareSwapAVX2(r0, r2);
+    compareSwapAVX2(r1, r3);
+    compareSwapAVX2(r1, r2);
+
+    __m256i a0 = _mm256_permute2x128_si256(r0, r1, 0x20); // Kolom 0
+    __m256i a1 = _mm256_permute2x128_si256(r2, r3, 0x20);
+    __m256i b0 = _mm256_permute2x128_si256(r0, r1, 0x31); // Kolom 1
+    __m256i b1 = _mm256_permute2x128_si256(r2, r3, 0x31);
+    bitonicMerge4AVX2(a0, a1, b0, b1);
+
+    storePairAVX2(block, a0);
+    storePairAVX2(block + 2, a1);
+    storePairAVX2(block + 4, b0);
+    storePairAVX2(block + 6, b1);
+}
+
+// --- AVX-512: 4 elemen per register ---
+
+__attribute__((target("avx512f")))
+inline void compareSwapAVX512(__m512i &a, __m512i &b) {
+    __mmask8 gt = _mm512_cmpgt_epi64_mask(a, b) & 0x55;
+    gt = (__mmask8)(gt | (gt << 1)); // Mask key -> seluruh lane
+    __m512i mn = _mm512_mask_blend_epi64(gt, a, b);
+    b = _mm512_mask_blend_epi64(gt, b, a);
+    a = mn;
+}
+
+// Compare-exchange di dalam satu register: perm memasangkan setiap lane dengan
+// lane lain sejauh Shift qword. Keputusan tukar diambil dari lane bawah (LowKeys
+// = bit qword key lane bawah) lalu disalin ke lane pasangannya
+template <int Shift, int LowKeys>
+__attribute__((target("avx512f")))
+inline __m512i sortLanesAVX512(__m512i x, __m512i perm) {
+    __m512i y = _mm512_permutex2var_epi64(x, perm, x);
+    __mmask8 swap = _mm512_cmpgt_epi64_mask(x, y) & LowKeys;
+    swap = (__mmask8)(swap | (swap << Shift)); // Lane bawah -> lane pasangan
+    swap = (__mmask8)(swap | (swap << 1));     // Mask key -> seluruh lane
+    return _mm512_mask_blend_epi64(swap, x, y);
+}
+
+// Merge bitonic 8 + 8, sama seperti versi AVX2 dengan register 2x lebih lebar
+__attribute__((target("avx512f")))
+inline void bitonicMerge8AVX512(__m512i &a0, __m512i &a1, __m512i &b0, __m512i &b1) {
+    const __m512i reverse = _mm512_set_epi64(1, 0, 3, 2, 5, 4, 7, 6); // Lane (3, 2, 1, 0)
+    const __m512i halves = _mm512_set_epi64(3, 2, 1, 0, 7, 6, 5, 4);  // Lane (2, 3, 0, 1)
+    const __m512i pairs = _mm512_set_epi64(5, 4, 7, 6, 1, 0, 3, 2);   // Lane (1, 0, 3, 2)
+    __m512i r0 = _mm512_permutex2var_epi64(b1, reverse, b1);
+    __m512i r1 = _mm512_permutex2var_epi64(b0, reverse, b0);
+    compareSwapAVX512(a0, r0); // Jarak 8
+    compareSwapAVX512(a1, r1);
+    compareSwapAVX512(a0, a1); // Jarak 4
+    compareSwapAVX512(r0, r1);
+    a0 = sortLanesAVX512<4, 0x05>(a0, halves); // Jarak 2
+    a1 = sortLanesAVX512<4, 0x05>(a1, halves);
+    r0 = sortLanesAVX512<4, 0x05>(r0, halves);
+    r1 = sortLanesAVX512<4, 0x05>(r1, halves);
+    a0 = sortLanesAVX512<2, 0x11>(a0, pairs); // Jarak 1
+    a1 = sortLanesAVX512<2, 0x11>(a1, pairs);
+    b0 = sortLanesAVX512<2, 0x11>(r0, pairs);
+    b1 = sortLanesAVX512<2, 0x11>(r1, pairs);
+}
+
+__attribute__((target("avx512f")))
+inline void mergeKeyIndexAVX512(const KeyIndex *a, const KeyIndex *a_end,
+                                const KeyIndex *b, const KeyIndex *b_end, KeyIndex *out) {
+    if (a_end - a < 8 || b_end - b < 8) {
+        mergeKeyIndexScalar(a, a_end, b, b_end, out);
+        return;
+    }
+
+    __m512i lo0 = _mm512_loadu_si512(a), lo1 = _mm512_loadu_si512(a + 4);
+    __m512i hi0 = _mm512_loadu_si512(b), hi1 = _mm512_loadu_si512(b + 4);
+    a += 8;
+    b += 8;
+
+    while (true) {
+        bitonicMerge8AVX512(lo0, lo1, hi0, hi1);
+        _mm512_storeu_si512(out, lo0);
+        _mm512_storeu_si512(out + 4, lo1);
+        out += 8;
+
+        if (a_end - a < 8 || b_end - b < 8) break;
+        const KeyIndex *&src = (a->sort_key <= b->sort_key) ? a : b;
+        lo0 = _mm512_loadu_si512(src);
+        lo1 = _mm512_loadu_si512(src + 4);
+        src += 8;
+    }
+
+    KeyIndex carry[8];
+    _mm512_storeu_si512(carry, hi0);
+    _mm512_storeu_si512(carry + 4, hi1);
+    mergeKeyIndexTail(carry, 8, a, a_end, b, b_end, out);
+}
+
+#endif
+
+// Pilih kernel terbaik yang didukung CPU (dicek sekali saja)
+inline KeyIndexMergeKernel selectKeyIndexMerge() {
+#ifdef SIMD_MERGE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return mergeKeyIndexAVX512;
+    if (__builtin_cpu_supports("avx2")) return mergeKeyIndexAVX2;
+#endif
+    return mergeKeyIndexScalar;
+}
+
+inline KeyIndexBlockKernel selectKeyIndexBlockSort() {
+#ifdef SIMD_MERGE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return sortKeyIndexBlockAVX2;
+#endif
+    return sortKeyIndexBlockScalar;
+}
+
+inline const KeyIndexMergeKernel mergeKeyIndex = selectKeyIndexMerge();
+inline const KeyIndexBlockKernel sortKeyIndexBlock = selectKeyIndexBlockSort();
+
+// Sort [first, last) untuk leaf merge sort: blok 8 elemen di-sort dengan
+// network, lalu merge bottom-up bolak-balik antara range ini dan tmp
+// (tmp minimal sepanjang range, isinya boleh ditimpa)
+inline void sortKeyIndex(KeyIndex *first, KeyIndex *last, KeyIndex *tmp) {
+    std::ptrdiff_t n = last - first;
+    std::ptrdiff_t full = n - n % KEY_INDEX_BLOCK;
+    for (std::ptrdiff_t i = 0; i < full; i += KEY_INDEX_BLOCK) sortKeyIndexBlock(first + i);
+    std::sort(first + full, last, [](const KeyIndex &x, const KeyIndex &y) {
+        return x.sort_key < y.sort_key;
+    });
+
+    KeyIndex *src = first, *dst = tmp;
+    for (std::ptrdiff_t width = KEY_INDEX_BLOCK; width < n; width *= 2) {
+        for (std::ptrdiff_t i = 0; i < n; i += 2 * width) {
+            std::ptrdiff_t mid = std::min(i + width, n), end = std::min(i + 2 * width, n);
+            mergeKeyIndex(src + i, src + mid, src + mid, src + end, dst + i);
+        }
+        std::swap(src, dst);
+    }
+    if (src != first) std::copy(src, src + n, first);
+}
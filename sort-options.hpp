@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// ==========================================
+// Command Line Options
+// ==========================================
+
+// Opsi yang sama untuk semua program sort:
+//   ./program <sort_field> [--key-index] [--stable] [--radix-bits 8|11|16] [--pin]
+//             [--format json|binary|indices] [--output PATH] [--limit K] [--offset N]
+struct SortOptions {
+    std::string sortField;
+    bool key_index = false; // Sort pasangan (sort_key, index) lalu terapkan urutan saat output
+    bool stable = false;    // Key sama tetap dalam urutan file (radix sort selalu stabil)
+    int radix_bits = 8;     // Lebar digit radix sort (hanya dipakai radix-sort)
+    bool pin_threads = false; // Pin worker thread ke core
+    std::string format = "json"; // json: baris di stdout, binary: file kolom, indices: permutasi saja
+    std::string output;          // Path file untuk format binary / indices
+    long long limit = -1;        // Hanya K baris hasil sort (-1 = semua)
+    long long offset = 0;        // Mulai dari posisi ke-N hasil sort
+
+    // Partial sort: hanya window [offset, offset + limit) yang diurutkan dan ditulis
+    bool hasWindow() const { return limit >= 0 || offset > 0; }
+};
+
+// Parse argv ke SortOptions, tulis pesan error ke err (default cerr) dan return false jika gagal
+inline bool parseSortOptions(int argc, char *argv[], SortOptions &options, std::ostream &err = std::cerr) {
+    if (argc < 2) {
+        err << "ERROR: missing sort field (e.g., ./program invoice_no)\n";
+        return false;
+    }
+    options.sortField = argv[1];
+
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--key-index") {
+            options.key_index = true;
+        } else if (arg == "--stable") {
+            options.stable = true;
+        } else if (arg == "--pin") {
+            options.pin_threads = true;
+        } else if (arg == "--radix-bits" && i + 1 < argc) {
+            options.radix_bits = std::atoi(argv[++i]);
+            if (options.radix_bits < 1 || options.radix_bits > 16) {
+                err << "ERROR: --radix-bits must be between 1 and 16\n";
+                return false;
+            }
+        } else if (arg == "--format" && i + 1 < argc) {
+            options.format = argv[++i];
+            if (options.format != "json" && options.format != "binary" && options.format != "indices") {
+                err << "ERROR: --format must be json, binary or indices\n";
+                return false;
+            }
+        } else if (arg == "--output" && i + 1 < argc) {
+            options.output = argv[++i];
+        } else if ((arg == "--limit" || arg == "--offset") && i + 1 < argc) {
+            const char *text = argv[++i];
+            char *end = nullptr;
+            long long value = std::strtoll(text, &end, 10);
+            if (end == text || *end != '\0' || value < 0) {
+                err << "ERROR: " << arg << " must be a non-negative integer\n";
+                return false;
+            }
+            (arg == "--limit" ? options.limit : options.offset) = value;
+        } else {
+            err << "ERROR: unknown option: " << arg << "\n";
+            return false;
+        }
+    }
+    if (options.format != "json" && options.output.empty()) {
+        err << "ERROR: --format " << options.format << " requires --output PATH\n";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "column-writer.hpp"
+#include "csv-reader.hpp"
+#include "json-writer.hpp"
+#include "sort-options.hpp"
+
+// ==========================================
+// Output Selection
+// ==========================================
+
+// Format file (binary, indices): tulis hasil sort ke options.output.
+// Return false (dan pesan di cerr) jika gagal menulis file output.
+inline bool writeSortedFile(const SortOptions &options, long long duration_ms,
+                            const std::vector<CustomerData> &data_customers, const std::vector<KeyIndex> *keys) {
+    return (options.format == "indices")
+               ? writeSortedIndices(options.output, data_customers, keys)
+               : writeSortedColumns(options.output, duration_ms, data_customers, keys);
+}
+
+// Metadata untuk format file:
+//   {"duration":..,"format":"binary","rows":..,"output":".."}
+inline void writeSortedMeta(const SortOptions &options, long long duration_ms, std::size_t rows, std::FILE *out) {
+    JsonWriter writer(out);
+    writer.raw("---START_JSON---\n{\"duration\":");
+    writer.number(duration_ms);
+    writer.raw(",\"format\":");
+    writer.string(options.format);
+    writer.raw(",\"rows\":");
+    writer.number((long long)rows);
+    writer.raw(",\"output\":");
+    writer.string(options.output);
+    writer.raw("}\n---END_JSON---\n");
+}
+
+// Tulis hasil sort sesuai --format. Framing ---START_JSON--- / ---END_JSON---
+// selalu ada di out; untuk format file (binary, indices) isinya hanya metadata.
+// Return false jika gagal menulis file output. out: stdout, atau koneksi klien di sort-server.
+inline bool writeSortedOutput(const SortOptions &options, long long duration_ms,
+                              const std::vector<CustomerData> &data_customers, const std::vector<KeyIndex> *keys,
+                              std::FILE *out = stdout) {
+    if (options.format == "json") {
+        writeSortedJson(duration_ms, data_customers, keys, out);
+        return true;
+    }
+
+    if (!writeSortedFile(options, duration_ms, data_customers, keys)) return false;
+    writeSortedMeta(options, duration_ms, sortedCount(data_customers, keys), out);
+    return true;
+}
@@ -0,0 +1,321 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <string>
+#include "csv-reader.hpp"
+#include "sort-output.hpp"
+#include "sort-options.hpp"
+#include "thread-pool.hpp"
+#include "quick-sort.hpp"
+#include "merge-sort.hpp"
+#include "radix-sort.hpp"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// ==========================================
+// Sort Server
+// ==========================================
+
+// Proses yang tetap hidup dan melayani request sort lewat Unix socket, jadi
+// baca + parse CSV dan pembuatan thread pool tidak dibayar di setiap request.
+//
+//   ./sort-server [--socket PATH] [--data PATH]
+//
+// Protokol (satu request per koneksi):
+//   klien -> server: satu baris "<quick|merge|radix> <sort_field> [opsi...]\n",
+//                    opsi sama dengan program sort (lihat sort-options.hpp)
+//   server -> klien: "OK\n" lalu output yang sama persis dengan stdout program sort
+//                    (---START_JSON--- ... ---END_JSON---), atau "ERROR <pesan>\n"
+//   lalu koneksi ditutup.
+//
+// Hasil parse setiap kolom di-cache (vector CustomerData per kolom CSV, nama
+// field yang tidak dikenal ditolak). Jika file CSV berubah (inode, mtime atau
+// ukuran), file dibaca ulang dan cache dikosongkan.
+// Request dilayani satu per satu: setiap sort sudah memakai semua core. Klien
+// yang tidak mengirim baris lengkap dalam REQUEST_TIMEOUT_MS diputus.
+
+const char *DEFAULT_SOCKET_PATH = "/tmp/sort-server.sock";
+const char *DEFAULT_DATA_PATH = "data/customer_shopping_data.csv";
+const std::size_t MAX_REQUEST = 4096;
+const int REQUEST_TIMEOUT_MS = 2000; // Batas waktu menerima baris request
+const int SEND_TIMEOUT_SEC = 30;     // Batas waktu satu write ke klien yang tidak membaca
+
+#ifndef _WIN32
+
+// Identitas file CSV: inode berbeda berarti file diganti (rename), mtime nanodetik
+// dan ukuran menangkap penulisan ulang di tempat dalam detik yang sama
+struct FileStamp {
+    dev_t dev = 0;
+    ino_t ino = 0;
+    off_t size = -1;
+    long long mtime_ns = 0;
+
+    static FileStamp of(const struct stat &st) {
+        FileStamp stamp;
+        stamp.dev = st.st_dev;
+        stamp.ino = st.st_ino;
+        stamp.size = st.st_size;
+#ifdef __APPLE__
+        stamp.mtime_ns = (long long)st.st_mtimespec.tv_sec * 1000000000LL + st.st_mtimespec.tv_nsec;
+#else
+        stamp.mtime_ns = (long long)st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+#endif
+        return stamp;
+    }
+
+    bool operator==(const FileStamp &o) const {
+        return dev == o.dev && ino == o.ino && size == o.size && mtime_ns == o.mtime_ns;
+    }
+};
+
+// Dataset yang tetap di memori selama server hidup
+struct Dataset {
+    std::string path;
+    bool loaded = false;
+    FileStamp stamp;
+    std::map<int, std::vector<CustomerData>> fields; // Hasil parse per kolom sort
+
+    // Baca ulang file jika berubah sejak terakhir dibaca. Isi file disalin ke memori
+    // (MappedFile::load), bukan di-mmap: file yang ditimpa dengan cp (truncate di
+    // inode yang sama) saat request berjalan tidak bisa membuat server mati karena
+    // SIGBUS. Return false jika gagal dibuka
+    bool refresh(std::string &error) {
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0) {
+            error = "cannot open file: " + path;
+            return false;
+        }
+        FileStamp current = FileStamp::of(st);
+        if (loaded && current == stamp) return true;
+
+        fields.clear(); // Offset record lama tidak berlaku untuk file baru
+        loaded = false;
+        if (!csv_file.load(path)) {
+            error = "cannot open file: " + path;
+            return false;
+        }
+        // Stamp diambil sebelum membaca: perubahan selama load terdeteksi di request berikutnya
+        stamp = current;
+        loaded = true;
+        return true;
+    }
+
+    // Record untuk kolom CSV (findColumn), di-parse sekali lalu dipakai ulang.
+    // Key cache adalah indeks kolom, jadi maksimal NUM_COLUMNS entry
+    const std::vector<CustomerData> &records(int column) {
+        auto it = fields.find(column);
+        if (it == fields.end()) {
+            it = fields.emplace(column, std::vector<CustomerData>()).first;
+            parseCSV(csv_columns[column], it->second);
+        }
+        return it->second;
+    }
+};
+
+// Pecah baris request menjadi argumen (dipisah spasi / tab)
+std::vector<std::string> splitRequest(const std::string &line) {
+    std::vector<std::string> args;
+    std::istringstream in(line);
+    std::string arg;
+    while (in >> arg) args.push_back(arg);
+    return args;
+}
+
+// Baca satu baris request (tanpa '\n'). Return false jika koneksi putus, terlalu
+// panjang, atau baris lengkap tidak diterima dalam REQUEST_TIMEOUT_MS: server
+// melayani satu klien sekaligus, jadi klien yang diam tidak boleh menahan antrian
+bool readRequest(int fd, std::string &line) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(REQUEST_TIMEOUT_MS);
+    char chunk[512];
+    while (line.size() < MAX_REQUEST) {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (left.count() <= 0) return false;
+
+        pollfd pfd = {fd, POLLIN, 0};
+        int ready = poll(&pfd, 1, (int)left.count());
+        if (ready < 0 && errno == EINTR) continue;
+        if (ready <= 0) return false; // Timeout atau error
+
+        ssize_t n = read(fd, chunk, sizeof(chunk));
+        if (n <= 0) return false;
+        for (ssize_t i = 0; i < n; i++) {
+            if (chunk[i] == '\n') return true; // Satu request per koneksi, sisa byte diabaikan
+            line.push_back(chunk[i]);
+        }
+    }
+    return false;
+}
+
+// Kirim "ERROR <pesan>\n" (satu baris) ke klien
+void sendError(std::FILE *out, const std::string &message) {
+    std::string line = message;
+    for (char &c : line) {
+        if (c == '\n') c = ' ';
+    }
+    while (!line.empty() && line.back() == ' ') line.pop_back();
+    if (line.compare(0, 7, "ERROR: ") == 0) line.erase(0, 7); // Pesan dari parseSortOptions
+    std::fprintf(out, "ERROR %s\n", line.c_str());
+}
+
+// Jalankan sort sesuai algoritma, sama dengan main() di quick-sort.cpp / merge-sort.cpp / radix-sort.cpp
+template <typename Record>
+void runSort(const std::string &algo, std::vector<Record> &records, const SortOptions &options) {
+    if (algo == "quick") runQuickSort(records, options);
+    else if (algo == "merge") runMergeSort(records, options);
+    else runRadixSort(records, options);
+}
+
+// Layani satu koneksi: parse request, sort dari cache, tulis hasil ke klien
+void handleClient(int fd, Dataset &dataset) {
+    std::FILE *out = fdopen(fd, "w");
+    if (!out) {
+        close(fd);
+        return;
+    }
+
+    std::string line;
+    if (!readRequest(fd, line)) {
+        sendError(out, "invalid request or timeout");
+        std::fclose(out);
+        return;
+    }
+
+    // argv untuk parseSortOptions: argv[0] = algoritma, argv[1] = sort field
+    std::vector<std::string> args = splitRequest(line);
+    std::vector<char *> argv;
+    for (auto &arg : args) argv.push_back(&arg[0]);
+
+    SortOptions options;
+    std::ostringstream error;
+    std::string open_error;
+    if (args.empty() || (args[0] != "quick" && args[0] != "merge" && args[0] != "radix")) {
+        sendError(out, "unknown algorithm (quick, merge or radix)");
+    } else if (!parseSortOptions((int)argv.size(), argv.data(), options, error)) {
+        sendError(out, error.str());
+    } else if (findColumn(options.sortField) < 0) {
+        sendError(out, "unknown sort field: " + options.sortField);
+    } else if (!dataset.refresh(open_error)) {
+        sendError(out, open_error);
+    } else {
+        const std::vector<CustomerData> &cached = dataset.records(findColumn(options.sortField));
+
+        // Mode key-index cukup membangun keys dari cache; selain itu record disalin
+        // karena sort bekerja in-place
+        std::vector<CustomerData> data_customers;
+        std::vector<KeyIndex> keys;
+        if (options.key_index) keys = buildKeyIndex(cached);
+        else data_customers = cached;
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        if (options.key_index) runSort(args[0], keys, options);
+        else runSort(args[0], data_customers, options);
+
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+        // Mode key-index: urutan ada di keys, record tetap dari cache
+        const std::vector<CustomerData> &sorted = options.key_index ? cached : data_customers;
+        const std::vector<KeyIndex> *sorted_keys = options.key_index ? &keys : nullptr;
+
+        // Format file: file ditulis dulu agar status OK / ERROR diketahui sebelum output
+        if (options.format == "json") {
+            std::fputs("OK\n", out);
+            writeSortedJson(duration.count(), sorted, sorted_keys, out);
+        } else if (writeSortedFile(options, duration.count(), sorted, sorted_keys)) {
+            std::fputs("OK\n", out);
+            writeSortedMeta(options, duration.count(), sortedCount(sorted, sorted_keys), out);
+        } else {
+            sendError(out, "failed writing output file: " + options.output);
+        }
+
+        std::cerr << "[sort-server] " << line << ": " << duration.count() << " ms" << std::endl;
+    }
+    std::fclose(out);
+}
+
+#endif
+
+// ==========================================
+// Bagian Main
+// ==========================================
+
+int main(int argc, char* argv[]) {
+#ifdef _WIN32
+    std::cerr << "ERROR: sort-server membutuhkan Unix domain socket (Linux / macOS)\n";
+    return 1;
+#else
+    std::string socket_path = DEFAULT_SOCKET_PATH;
+    Dataset dataset;
+    dataset.path = DEFAULT_DATA_PATH;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--socket" && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if (arg == "--data" && i + 1 < argc) {
+            dataset.path = argv[++i];
+        } else {
+            std::cerr << "ERROR: unknown option: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "ERROR: socket path too long: " << socket_path << "\n";
+        return 1;
+    }
+    std::strcpy(addr.sun_path, socket_path.c_str());
+
+    // Klien yang putus di tengah output tidak boleh mematikan server
+    std::signal(SIGPIPE, SIG_IGN);
+
+    // Muat data dan buat thread pool sebelum menerima request pertama
+    std::string error;
+    if (!dataset.refresh(error)) {
+        std::cerr << "[ERROR] " << error << "\n";
+        return 1;
+    }
+    ThreadPool::instance();
+
+    int server_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server_fd < 0) {
+        std::perror("socket");
+        return 1;
+    }
+    unlink(socket_path.c_str()); // Sisa socket dari proses sebelumnya
+    if (bind(server_fd, (sockaddr *)&addr, sizeof(addr)) != 0 || listen(server_fd, 16) != 0) {
+        std::perror("bind");
+        close(server_fd);
+        return 1;
+    }
+    std::cerr << "[sort-server] listening on " << socket_path << " (" << ThreadPool::instance().size()
+              << " threads)" << std::endl;
+
+    while (true) {
+        int client_fd = accept(server_fd, nullptr, nullptr);
+        if (client_fd < 0) continue;
+
+        // Klien yang berhenti membaca output juga tidak boleh menahan server selamanya
+        timeval send_timeout = {SEND_TIMEOUT_SEC, 0};
+        setsockopt(client_fd, SOL_SOCKET, SO_SNDTIMEO, &send_timeout, sizeof(send_timeout));
+        handleClient(client_fd, dataset);
+    }
+#endif
+}
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ==========================================
+// Bagian Header (ThreadPool & TaskGroup)
+// ==========================================
+
+// Pool thread yang dibuat sekali per proses lalu dipakai ulang oleh semua
+// sorter, jadi biaya membuat std::thread tidak dibayar di setiap split.
+//
+// Penjadwalan work-stealing: setiap worker punya deque sendiri. Task yang
+// dibuat worker masuk ke belakang deque-nya dan diambil lagi dari belakang
+// (LIFO, data masih hangat di cache). Worker yang menganggur mencuri dari
+// depan deque worker lain (FIFO, biasanya subrange terbesar). Task dari
+// thread di luar pool masuk ke deque tambahan (injection queue).
+class ThreadPool {
+private:
+    struct WorkQueue {
+        std::mutex m;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkQueue>> queues; // [0..workers) milik worker, [workers] injection queue
+    std::atomic<int> queued;                        // Total task di semua deque
+    std::mutex m;
+    std::condition_variable cv; // Dibangunkan saat ada task baru / group selesai
+    bool stopping;
+
+    void workerLoop(int index);
+    int currentQueue();                                      // Deque milik thread saat ini
+    bool popTask(int index, std::function<void()> &task);    // Ambil dari belakang (pemilik)
+    bool stealTask(int index, std::function<void()> &task);  // Ambil dari depan (pencuri)
+
+public:
+    explicit ThreadPool(unsigned int num_workers);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // Pool global: hardware_concurrency - 1 worker, thread pemanggil ikut bekerja saat wait()
+    static ThreadPool &instance();
+
+    unsigned int size() const { return (unsigned int)workers.size() + 1; } // Termasuk thread pemanggil
+
+    void submit(std::function<void()> task); // Masukkan task ke deque thread saat ini
+    bool runPendingTask();                   // Jalankan satu task (milik sendiri atau curian) jika ada
+
+    // Tidur sampai ada task di salah satu deque atau done() bernilai true
+    template <typename Predicate>
+    void waitForWork(Predicate done) {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [this, &done] { return queued.load(std::memory_order_acquire) > 0 || done(); });
+    }
+
+    void notifyAll(); // Bangunkan semua thread yang sedang waitForWork
+};
+
+// Fork/join di atas ThreadPool: run() menitipkan task ke pool, wait() menunggu
+// semua task group ini selesai sambil ikut menjalankan task lain di antrian
+// (sehingga rekursi bersarang tidak pernah deadlock).
+class TaskGroup {
+private:
+    ThreadPool &pool;
+    std::atomic<int> pending;
+
+public:
+    explicit TaskGroup(ThreadPool &pool = ThreadPool::instance()) : pool(pool), pending(0) {}
+    ~TaskGroup() { wait(); }
+
+    void run(std::function<void()> fn);
+    void wait();
+};
+
+// ==========================================
+// Bagian Implementasi (ThreadPool & TaskGroup)
+// ==========================================
+
+// Pool tempat thread saat ini menjadi worker (nullptr untuk thread di luar pool)
+inline thread_local ThreadPool *current_pool = nullptr;
+inline thread_local int current_worker = -1;
+
+inline ThreadPool::ThreadPool(unsigned int num_workers) : queued(0), stopping(false) {
+    for (unsigned int i = 0; i <= num_workers; i++) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (unsigned int i = 0; i < num_workers; i++) {
+        workers.emplace_back([this, i] { workerLoop((int)i); });
+    }
+}
+
+inline ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m);
+        stopping = true;
+    }
+    cv.notify_all();
+    for (auto &t : workers) t.join();
+}
+
+inline ThreadPool &ThreadPool::instance() {
+    // Deteksi otomatis jumlah Core CPU, default ke 2 jika gagal
+    static ThreadPool pool([] {
+        unsigned int cores = std::thread::hardware_concurrency();
+        if (cores == 0) cores = 2;
+        return cores - 1;
+    }());
+    return pool;
+}
+
+inline int ThreadPool::currentQueue() {
+    return (current_pool == this) ? current_worker : (int)workers.size();
+}
+
+inline void ThreadPool::workerLoop(int index) {
+    current_pool = this;
+    current_worker = index;
+
+    while (true) {
+        if (runPendingTask()) continue;
+
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [this] { return stopping || queued.load(std::memory_order_acquire) > 0; });
+        if (stopping && queued.load(std::memory_order_acquire) == 0) return;
+    }
+}
+
+inline bool ThreadPool::popTask(int index, std::function<void()> &task) {
+    WorkQueue &q = *queues[index];
+    std::lock_guard<std::mutex> lock(q.m);
+    if (q.tasks.empty()) return false;
+    task = std::move(q.tasks.back());
+    q.tasks.pop_back();
+    return true;
+}
+
+inline bool ThreadPool::stealTask(int index, std::function<void()> &task) {
+    int n = (int)queues.size();
+    for (int k = 1; k < n; k++) {
+        WorkQueue &q = *queues[(index + k) % n]; // Mulai dari tetangga agar korban tersebar
+        std::lock_guard<std::mutex> lock(q.m);
+        if (q.tasks.empty()) continue;
+        task = std::move(q.tasks.front());
+        q.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+inline void ThreadPool::submit(std::function<void()> task) {
+    WorkQueue &q = *queues[currentQueue()];
+    {
+        std::lock_guard<std::mutex> lock(q.m);
+        q.tasks.push_back(std::move(task));
+    }
+    queued.fetch_add(1, std::memory_order_release);
+    { std::lock_guard<std::mutex> lock(m); } // Sinkron dengan thread yang sedang cek predikat
+    cv.notify_one();
+}
+
+inline bool ThreadPool::runPendingTask() {
+    int index = currentQueue();
+    std::function<void()> task;
+    if (!popTask(index, task) && !stealTask(index, task)) return false;
+    queued.fetch_sub(1, std::memory_order_acq_rel);
+    task();
+    return true;
+}
+
+inline void ThreadPool::notifyAll() {
+    { std::lock_guard<std::mutex> lock(m); } // Sinkron dengan thread yang sedang cek predikat
+    cv.notify_all();
+}
+
+inline void TaskGroup::run(std::function<void()> fn) {
+    pending.fetch_add(1, std::memory_order_relaxed);
+    // Pool di-capture langsung: setelah pending jadi 0, TaskGroup boleh sudah hilang
+    pool.submit([this, &pool = pool, fn = std::move(fn)] {
+        fn();
+        if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            pool.notifyAll(); // Task terakhir group ini: bangunkan yang menunggu di wait()
+        }
+    });
+}
+
+inline void TaskGroup::wait() {
+    while (pending.load(std::memory_order_acquire) > 0) {
+        if (pool.runPendingTask()) continue; // Bantu kerjakan task lain selagi menunggu
+        pool.waitForWork([this] { return pending.load(std::memory_order_acquire) == 0; });
+    }
+}